@@ -11,6 +11,20 @@ const docs = [{a: 1}, {a: 2}, {a: 3}, {a: 4}, {a: 5}, {a: 6}, {a: 7}, {a: 8}];
 const kBatchSize = 3;
 const kNoOfDocs = docs.length;
 
+// Because the first batch is returned from a find command without exhaustAllowed bit, moreToCome
+// bit is not set in reply message. The last batch which does not contain the full batch size is
+// returned without moreToCome bit set either.
+function verifyMoreToCome(cursor, docIdx, doc) {
+    const isFirstBatch = docIdx < kBatchSize;
+    const isLastBatch = docIdx >= kNoOfDocs - (kNoOfDocs % kBatchSize);
+
+    if (isFirstBatch || isLastBatch) {
+        assert(!cursor._hasMoreToCome(), `${docIdx} doc: ${doc}`);
+    } else {
+        assert(cursor._hasMoreToCome(), `${docIdx} doc: ${doc}`);
+    }
+}
+
 [{
     "setUp": () => {
         const conn = MongoRunner.runMongod();
@@ -18,21 +32,7 @@ const kNoOfDocs = docs.length;
         return {"env": conn, "db": db};
     },
     "tearDown": (env) => MongoRunner.stopMongod(env),
-    "verifyThis": (cursor, docIdx, doc) => {
-        // Because the first batch is returned from a find command without exhaustAllowed bit,
-        // moreToCome bit is not set in reply message.
-        const isFirstBatch = docIdx < kBatchSize;
-
-        // The last batch which does not contain the full batch size is returned without moreToCome
-        // bit set.
-        const isLastBatch = docIdx >= kNoOfDocs - (kNoOfDocs % kBatchSize);
-
-        if (isFirstBatch || isLastBatch) {
-            assert(!cursor._hasMoreToCome(), `${docIdx} doc: ${doc}`);
-        } else {
-            assert(cursor._hasMoreToCome(), `${docIdx} doc: ${doc}`);
-        }
-    }
+    "verifyThis": verifyMoreToCome
 },
  {
      "setUp": () => {
@@ -41,11 +41,20 @@ const kNoOfDocs = docs.length;
          return {"env": st, "db": db};
      },
      "tearDown": (env) => env.stop(),
-     "verifyThis": (cursor, docIdx, doc) => {
-         // Mongos does not support exhaust queries, not by returning an error but by sending reply
-         // without moreToCome bit set. So, _hasMoreToCome() is always false.
-         assert(!cursor._hasMoreToCome(), `${docIdx} doc: ${doc}`);
-     }
+     "verifyThis": verifyMoreToCome
+ },
+ {
+     "setUp": () => {
+         const st = new ShardingTest({
+             shards: 1,
+             config: 1,
+             other: {mongosOptions: {setParameter: {clusterCursorPrefetchMaxBufferedBytes: 1024}}}
+         });
+         const db = st.s0.getDB(jsTestName());
+         return {"env": st, "db": db};
+     },
+     "tearDown": (env) => env.stop(),
+     "verifyThis": verifyMoreToCome
  }].forEach(({setUp, tearDown, verifyThis}) => {
     const {env, db} = setUp();
 
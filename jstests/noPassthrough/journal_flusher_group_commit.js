@@ -0,0 +1,64 @@
+/**
+ * Tests that concurrent {j: true} writes are released by shared journal flusher rounds when
+ * journalGroupCommitMaxDelayMicros is set, and that durability waits are reported in serverStatus.
+ *
+ * @tags: [requires_journaling, requires_persistence]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {journalGroupCommitMaxDelayMicros: 5000}});
+const db = conn.getDB("test");
+
+function getJournalFlusherMetrics() {
+    const status = assert.commandWorked(db.adminCommand({serverStatus: 1}));
+    return status.metrics.journalFlusher;
+}
+
+const before = getJournalFlusherMetrics();
+
+const kNumWriters = 8;
+const kWritesPerWriter = 100;
+const awaitShells = [];
+for (let i = 0; i < kNumWriters; ++i) {
+    awaitShells.push(startParallelShell(
+        funWithArgs(function(writer, numWrites) {
+            const coll = db.getSiblingDB("test").journal_flusher_group_commit;
+            for (let j = 0; j < numWrites; ++j) {
+                assert.commandWorked(
+                    coll.insert({writer: writer, j: j}, {writeConcern: {j: true}}));
+            }
+        }, i, kWritesPerWriter), conn.port));
+}
+awaitShells.forEach((awaitShell) => awaitShell());
+
+assert.eq(kNumWriters * kWritesPerWriter, db.journal_flusher_group_commit.count());
+
+const after = getJournalFlusherMetrics();
+jsTestLog("Journal flusher metrics: " + tojson(after));
+
+// With several writers waiting concurrently, rounds were held open for more waiters to join, and
+// rounds released more than one waiter on average.
+const waiters = after.groupCommit.waiters - before.groupCommit.waiters;
+const rounds = after.groupCommit.rounds - before.groupCommit.rounds;
+assert.gte(waiters, kNumWriters * kWritesPerWriter, tojson(after));
+assert.gt(rounds, 0, tojson(after));
+assert.lt(rounds, waiters, tojson(after));
+assert.gt(after.groupCommit.delayedRounds, before.groupCommit.delayedRounds, tojson(after));
+
+const waitLatency = after.waitLatency.durabilityWaitMicros;
+assert.gte(waitLatency.ops - before.waitLatency.durabilityWaitMicros.ops,
+           kNumWriters * kWritesPerWriter,
+           tojson(after));
+
+// Setting the delay back to 0 disables holding rounds open.
+assert.commandWorked(db.adminCommand({setParameter: 1, journalGroupCommitMaxDelayMicros: 0}));
+const delayedRounds = getJournalFlusherMetrics().groupCommit.delayedRounds;
+for (let i = 0; i < 10; ++i) {
+    assert.commandWorked(
+        db.journal_flusher_group_commit.insert({serial: i}, {writeConcern: {j: true}}));
+}
+assert.eq(delayedRounds, getJournalFlusherMetrics().groupCommit.delayedRounds);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,55 @@
+/**
+ * Tests that serverStatus reports the latency breakdown of w:"majority" write concern waits, and
+ * that replication waits which time out are recorded as well.
+ * @tags: [
+ *   requires_journaling,
+ *   requires_persistence,
+ *   requires_replication,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/write_concern_util.js");
+
+const rst = new ReplSetTest({nodes: [{}, {rsConfig: {priority: 0}}]});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+const coll = primary.getDB("test").majority_write_concern_wait_latency;
+
+function getMajorityWaitLatency() {
+    const status = assert.commandWorked(primary.adminCommand({serverStatus: 1}));
+    return status.metrics.getLastError.majorityWaitLatency;
+}
+
+// A w:"majority" write that is acknowledged records both parts of the wait.
+let before = getMajorityWaitLatency();
+assert.commandWorked(coll.insert({_id: 1}, {writeConcern: {w: "majority"}}));
+let after = getMajorityWaitLatency();
+assert.gte(after.journalWaitMicros.ops, before.journalWaitMicros.ops + 1, tojson(after));
+assert.gte(after.replicationWaitMicros.ops, before.replicationWaitMicros.ops + 1, tojson(after));
+
+// Other write concerns are not recorded.
+before = getMajorityWaitLatency();
+assert.commandWorked(coll.insert({_id: 2}, {writeConcern: {w: 1}}));
+after = getMajorityWaitLatency();
+assert.eq(before.replicationWaitMicros.ops, after.replicationWaitMicros.ops, tojson(after));
+
+// A replication wait that times out is recorded with the time it spent waiting.
+const wtimeout = 1000;
+stopServerReplication(secondary);
+before = getMajorityWaitLatency();
+checkWriteConcernTimedOut(coll.runCommand(
+    {insert: coll.getName(), documents: [{_id: 3}], writeConcern: {w: "majority", wtimeout}}));
+after = getMajorityWaitLatency();
+assert.gte(after.replicationWaitMicros.ops, before.replicationWaitMicros.ops + 1, tojson(after));
+assert.gte(after.replicationWaitMicros.sum,
+           (before.replicationWaitMicros.sum || 0) + wtimeout * 1000,
+           tojson(after));
+restartServerReplication(secondary);
+
+rst.stopSet();
+})();
@@ -0,0 +1,100 @@
+/**
+ * Tests that identical concurrent finds by _id share a single execution when
+ * coalesceIdenticalPointReads is enabled, that a find never joins one which already opened its
+ * snapshot, and that the outcome is reported in serverStatus.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+load("jstests/libs/parallel_shell_helpers.js");
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.point_read_coalescing;
+assert.commandWorked(coll.insert([{_id: 1, x: 1}, {_id: 2, x: 2}]));
+
+function getCoalescingMetrics() {
+    const status = assert.commandWorked(db.adminCommand({serverStatus: 1}));
+    return status.metrics.query.pointReadCoalescing;
+}
+
+function assertFindsOne(id) {
+    assert.eq([{_id: id, x: id}], coll.find({_id: id}).toArray());
+}
+
+// Coalescing is off by default.
+let before = getCoalescingMetrics();
+assertFindsOne(1);
+assert.docEq(before, getCoalescingMetrics());
+
+assert.commandWorked(db.adminCommand({setParameter: 1, coalesceIdenticalPointReads: true}));
+
+// A point read with nothing to join executes on its own as a leader.
+before = getCoalescingMetrics();
+assertFindsOne(1);
+let after = getCoalescingMetrics();
+assert.eq(before.leaders + 1, after.leaders, tojson(after));
+assert.eq(before.hits, after.hits, tojson(after));
+
+// Queries that are not point reads by _id are never coalesced.
+before = getCoalescingMetrics();
+assert.eq(2, coll.find({x: {$gte: 1}}).itcount());
+assert.docEq(before, getCoalescingMetrics());
+
+function startPointRead(id, expectedX) {
+    const readFn = function(id, expectedX) {
+        const coll = db.getSiblingDB("test").point_read_coalescing;
+        assert.eq([{_id: id, x: expectedX}], coll.find({_id: id}).toArray());
+    };
+    return startParallelShell(funWithArgs(readFn, id, expectedX), conn.port);
+}
+
+// Hold a leader before it opens its snapshot, and let an identical read join it. The follower must
+// be answered with the leader's reply instead of executing.
+let leaderFailPoint = configureFailPoint(conn, "hangBeforePointReadLeaderExecutes");
+const followerFailPoint = configureFailPoint(conn, "hangAfterJoiningPointRead");
+before = getCoalescingMetrics();
+
+let awaitShells = [startPointRead(2, 2)];
+leaderFailPoint.wait();
+awaitShells.push(startPointRead(2, 2));
+followerFailPoint.wait();
+followerFailPoint.off();
+leaderFailPoint.off();
+awaitShells.forEach((awaitShell) => awaitShell());
+
+after = getCoalescingMetrics();
+assert.eq(before.leaders + 1, after.leaders, tojson(after));
+assert.eq(before.hits + 1, after.hits, tojson(after));
+assert.eq(before.fallbacks, after.fallbacks, tojson(after));
+
+// Hold a leader after it opened its snapshot, and update the document it reads. An identical read
+// issued after the update must not join the leader, and must observe the update.
+leaderFailPoint =
+    configureFailPoint(conn, "waitInFindBeforeMakingBatch", {nss: coll.getFullName()});
+before = getCoalescingMetrics();
+
+function numPointReadsWaitingForBatch() {
+    return db.getSiblingDB("admin")
+        .aggregate([
+            {$currentOp: {}},
+            {$match: {"command.find": coll.getName(), failpointMsg: "waitInFindBeforeMakingBatch"}}
+        ])
+        .itcount();
+}
+
+awaitShells = [startPointRead(2, 2)];
+assert.soon(() => numPointReadsWaitingForBatch() === 1);
+assert.commandWorked(coll.update({_id: 2}, {$set: {x: 3}}));
+awaitShells.push(startPointRead(2, 3));
+assert.soon(() => numPointReadsWaitingForBatch() === 2);
+leaderFailPoint.off();
+awaitShells.forEach((awaitShell) => awaitShell());
+
+after = getCoalescingMetrics();
+assert.eq(before.leaders + 2, after.leaders, tojson(after));
+assert.eq(before.hits, after.hits, tojson(after));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,77 @@
+/**
+ * Tests that ShardingTaskExecutorPoolMaxSizeAcrossExecutors bounds the number of connections mongos
+ * opens to a shard host summed across all of the executors in its sharding task executor pool.
+ *
+ * @tags: [requires_replication, requires_sharding, sets_replica_set_matching_strategy]
+ */
+load("jstests/libs/parallelTester.js");
+
+(function() {
+"use strict";
+
+const kDbName = 'test';
+const kNumExecutors = 2;
+const kMaxSizeAcrossExecutors = 4;
+const kNumFinds = 10;
+
+const st = new ShardingTest({
+    config: {nodes: 1},
+    shards: 1,
+    rs0: {nodes: 1},
+    mongos: [{
+        setParameter: {
+            taskExecutorPoolSize: kNumExecutors,
+            ShardingTaskExecutorPoolMinSize: 0,
+            ShardingTaskExecutorPoolMaxSizeAcrossExecutors: kMaxSizeAcrossExecutors,
+            ShardingTaskExecutorPoolReplicaSetMatching: "disabled",
+        }
+    }],
+});
+const mongos = st.s0;
+const primary = st.rs0.getPrimary();
+
+assert.commandWorked(mongos.getDB(kDbName).test.insert({x: 1}));
+
+function configureFindFailpoint(mode) {
+    assert.commandWorked(primary.adminCommand({
+        configureFailPoint: "waitInFindBeforeMakingBatch",
+        mode: mode,
+        data: {shouldCheckForInterrupt: true, nss: kDbName + ".test"},
+    }));
+}
+
+function getPrimaryInUse() {
+    const stats = assert.commandWorked(mongos.adminCommand({connPoolStats: 1})).hosts[primary.host];
+    jsTestLog("Connection stats for " + primary.host + ": " + tojson(stats));
+    return stats ? stats.inUse : 0;
+}
+
+assert.commandWorked(mongos.adminCommand({dropConnections: 1, hostAndPort: [primary.host]}));
+configureFindFailpoint("alwaysOn");
+
+const threads = [];
+for (let i = 0; i < kNumFinds; i++) {
+    const thread = new Thread(function(connStr, dbName) {
+        const client = new Mongo(connStr);
+        assert.commandWorked(client.getDB(dbName).runCommand({find: "test", limit: 1}));
+    }, mongos.host, kDbName);
+    thread.start();
+    threads.push(thread);
+}
+
+// Each executor with outstanding requests is always allowed one connection, so the limit can only
+// be exceeded by one connection per executor.
+assert.soon(() => getPrimaryInUse() >= kMaxSizeAcrossExecutors);
+sleep(2000);
+assert.lte(getPrimaryInUse(), kMaxSizeAcrossExecutors + kNumExecutors - 1);
+
+// Lifting the limit lets the blocked finds open the connections they need.
+assert.commandWorked(
+    mongos.adminCommand({setParameter: 1, ShardingTaskExecutorPoolMaxSizeAcrossExecutors: 0}));
+assert.soon(() => getPrimaryInUse() == kNumFinds);
+
+configureFindFailpoint("off");
+threads.forEach((thread) => thread.join());
+
+st.stop();
+})();
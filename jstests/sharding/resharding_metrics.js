@@ -145,6 +145,7 @@ function verifyCurrentOpOutput(reshardingTest, inputCollection) {
     if (!reshardingTest.isMixedVersionCluster()) {
         expectedRecipientMetrics.oplogApplierApplyBatchLatencyMillis = undefined;
         expectedRecipientMetrics.collClonerFillBatchForInsertLatencyMillis = undefined;
+        expectedRecipientMetrics.totalIndexBuildTimeElapsedSecs = undefined;
     }
 
     reshardingTest.recipientShardNames.forEach(function(shardName) {
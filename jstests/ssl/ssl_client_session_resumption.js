@@ -0,0 +1,61 @@
+// Test that outgoing intra-cluster connections resume cached TLS sessions when
+// tlsClientSessionCacheSize is set, and that full handshakes remain the default.
+
+(function() {
+"use strict";
+load("jstests/ssl/libs/ssl_helpers.js");
+
+// Only the OpenSSL manager caches client sessions.
+if (determineSSLProvider() !== "openssl") {
+    jsTestLog("SSL provider is not OpenSSL; skipping test.");
+    return;
+}
+
+const base_options = {
+    tlsMode: 'requireTLS',
+    tlsCertificateKeyFile: 'jstests/libs/server.pem',
+    tlsCAFile: 'jstests/libs/ca.pem',
+    tlsAllowInvalidHostnames: '',
+};
+
+function getResumptionCounts(node) {
+    const status = assert.commandWorked(node.adminCommand({serverStatus: 1}));
+    assert(status.hasOwnProperty('tlsSessionResumption'), tojson(status));
+    return status.tlsSessionResumption;
+}
+
+function testRS(opts, expectResumption) {
+    const rs = new ReplSetTest({nodes: {node0: opts, node1: opts}});
+    rs.startSet();
+    rs.initiate();
+    rs.awaitReplication();
+
+    const primary = rs.getPrimary();
+    const secondary = rs.getSecondary();
+
+    // Force the primary to reconnect to the secondary a few times. Heartbeats re-establish the
+    // dropped connections, and each one can offer the session negotiated by the previous one.
+    for (let i = 0; i < 3; ++i) {
+        assert.commandWorked(
+            primary.adminCommand({dropConnections: 1, hostAndPort: [secondary.host]}));
+        sleep(3 * 1000);
+    }
+
+    if (expectResumption) {
+        assert.soon(() => getResumptionCounts(primary).egress > 0,
+                    () => "Primary never resumed a TLS session: " +
+                        tojson(getResumptionCounts(primary)));
+        assert.soon(() => getResumptionCounts(secondary).ingress > 0,
+                    () => "Secondary never accepted a resumed TLS session: " +
+                        tojson(getResumptionCounts(secondary)));
+    } else {
+        assert.eq(0, getResumptionCounts(primary).egress);
+        assert.eq(0, getResumptionCounts(secondary).egress);
+    }
+
+    rs.stopSet();
+}
+
+testRS(base_options, false);
+testRS(Object.extend({setParameter: {tlsClientSessionCacheSize: 10}}, base_options), true);
+}());
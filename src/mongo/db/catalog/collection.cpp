@@ -49,6 +49,9 @@ void CappedInsertNotifier::notifyAll() const {
 
 void CappedInsertNotifier::waitUntil(uint64_t prevVersion, Date_t deadline) const {
     stdx::unique_lock<Latch> lk(_mutex);
+    if (_onWait && !_dead && prevVersion == _version) {
+        _onWait();
+    }
     while (!_dead && prevVersion == _version) {
         if (stdx::cv_status::timeout == _notifier.wait_until(lk, deadline.toSystemTimePoint())) {
             return;
@@ -110,6 +110,14 @@ struct CollectionUpdateArgs {
  */
 class CappedInsertNotifier {
 public:
+    CappedInsertNotifier() = default;
+
+    /**
+     * 'onWait' is invoked, with the notifier's mutex held, whenever a thread is about to block in
+     * waitUntil(). It must not call back into the notifier.
+     */
+    explicit CappedInsertNotifier(std::function<void()> onWait) : _onWait(std::move(onWait)) {}
+
     /**
      * Wakes up all threads waiting.
      */
@@ -155,6 +163,9 @@ private:
 
     // True once the notifier is dead.
     bool _dead = false;
+
+    // Invoked before a thread blocks in waitUntil(). Never called once the notifier is dead.
+    const std::function<void()> _onWait;
 };
 
 /**
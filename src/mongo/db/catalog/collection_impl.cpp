@@ -275,13 +275,27 @@ bool indexTypeSupportsPathLevelMultikeyTracking(StringData accessMethod) {
 
 }  // namespace
 
+std::shared_ptr<CappedInsertNotifier> CollectionImpl::SharedState::_makeCappedNotifier(
+    const NamespaceString& nss, const RecordStore* recordStore, const CollectionOptions& options) {
+    if (!recordStore || !options.capped) {
+        return nullptr;
+    }
+    if (nss.isOplog()) {
+        // Let the storage engine publish pending oplog entries as soon as a tailing reader, such
+        // as a secondary's oplog fetcher, waits for them. The notifier is killed before the
+        // record store is destroyed, after which the callback is never invoked.
+        return std::make_shared<CappedInsertNotifier>(
+            [recordStore] { recordStore->notifyOplogReaderWaiting(); });
+    }
+    return std::make_shared<CappedInsertNotifier>();
+}
+
 CollectionImpl::SharedState::SharedState(CollectionImpl* collection,
                                          std::unique_ptr<RecordStore> recordStore,
                                          const CollectionOptions& options)
     : _collectionLatest(collection),
       _recordStore(std::move(recordStore)),
-      _cappedNotifier(_recordStore && options.capped ? std::make_shared<CappedInsertNotifier>()
-                                                     : nullptr),
+      _cappedNotifier(_makeCappedNotifier(collection->ns(), _recordStore.get(), options)),
       _needCappedLock(options.capped && collection->ns().db() != "local"),
       _isCapped(options.capped),
       _cappedMaxDocs(options.cappedMaxDocs) {
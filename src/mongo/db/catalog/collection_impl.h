@@ -510,6 +510,11 @@ private:
         void instanceCreated(CollectionImpl* collection);
         void instanceDeleted(CollectionImpl* collection);
 
+        static std::shared_ptr<CappedInsertNotifier> _makeCappedNotifier(
+            const NamespaceString& nss,
+            const RecordStore* recordStore,
+            const CollectionOptions& options);
+
         bool haveCappedWaiters() const final;
         void notifyCappedWaitersIfNeeded() const final;
         Status aboutToDeleteCapped(OperationContext* opCtx,
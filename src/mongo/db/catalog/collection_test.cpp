@@ -114,6 +114,24 @@ TEST_F(CollectionTest, CappedNotifierWaitAfterNotifyIsImmediate) {
     ASSERT_LT(after - before, Seconds(25));
 }
 
+TEST_F(CollectionTest, CappedNotifierInvokesOnWaitOnlyWhenBlocking) {
+    int numWaits = 0;
+    CappedInsertNotifier notifier([&numWaits] { ++numWaits; });
+
+    // Waiting on a version that is already stale returns without blocking.
+    auto prevVersion = notifier.getVersion();
+    notifier.notifyAll();
+    notifier.waitUntil(prevVersion, Date_t::now() + Seconds(25));
+    ASSERT_EQ(numWaits, 0);
+
+    notifier.waitUntil(notifier.getVersion(), Date_t::now() + Milliseconds(1));
+    ASSERT_EQ(numWaits, 1);
+
+    notifier.kill();
+    notifier.waitUntil(notifier.getVersion(), Date_t::now() + Seconds(25));
+    ASSERT_EQ(numWaits, 1);
+}
+
 TEST_F(CollectionTest, CappedNotifierWaitUntilAsynchronousNotifyAll) {
     NamespaceString nss("test.t");
     makeCapped(nss);
@@ -0,0 +1,303 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands/aggregation_result_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/aggregation_result_cache_gen.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+const auto getAggregationResultCache =
+    ServiceContext::declareDecoration<std::unique_ptr<AggregationResultCache>>();
+
+const auto aggregationResultCacheRegisterer = ServiceContext::ConstructorActionRegisterer{
+    "AggregationResultCache", [](ServiceContext* serviceContext) {
+        getAggregationResultCache(serviceContext) =
+            std::make_unique<AggregationResultCache>(gAggregationResultCacheSizeBytes);
+    }};
+
+// Stages whose output is determined entirely by their input documents and arguments.
+const StringDataSet kCacheableStages{"$addFields",
+                                     "$bucket",
+                                     "$bucketAuto",
+                                     "$count",
+                                     "$group",
+                                     "$limit",
+                                     "$match",
+                                     "$project",
+                                     "$redact",
+                                     "$replaceRoot",
+                                     "$replaceWith",
+                                     "$set",
+                                     "$setWindowFields",
+                                     "$skip",
+                                     "$sort",
+                                     "$sortByCount",
+                                     "$unset",
+                                     "$unwind"};
+
+// Operators which are nondeterministic or run server-side JavaScript.
+const StringDataSet kNonCacheableOperators{
+    "$accumulator", "$function", "$rand", "$sampleRate", "$where"};
+
+// System variables whose value differs between executions of the same command.
+const std::vector<StringData> kNonCacheableVariables{
+    "$$NOW"_sd, "$$CLUSTER_TIME"_sd, "$$JS_SCOPE"_sd, "$$IS_MR"_sd, "$$SEARCH_META"_sd};
+
+bool isCacheableValue(const BSONElement& elem);
+
+bool isCacheableObject(const BSONObj& obj) {
+    for (auto&& elem : obj) {
+        if (kNonCacheableOperators.count(elem.fieldNameStringData()) || !isCacheableValue(elem)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isCacheableValue(const BSONElement& elem) {
+    switch (elem.type()) {
+        case Object:
+        case Array:
+            return isCacheableObject(elem.embeddedObject());
+        case String: {
+            auto str = elem.valueStringData();
+            return std::none_of(kNonCacheableVariables.begin(),
+                                kNonCacheableVariables.end(),
+                                [&](StringData variable) { return str.startsWith(variable); });
+        }
+        case CodeWScope:
+        case Code:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool isCacheablePipeline(const std::vector<BSONObj>& pipeline) {
+    return std::all_of(pipeline.begin(), pipeline.end(), [](const BSONObj& stage) {
+        return stage.nFields() == 1 &&
+            kCacheableStages.count(stage.firstElementFieldNameStringData()) &&
+            isCacheableObject(stage);
+    });
+}
+
+bool isCacheableReadConcern(OperationContext* opCtx) {
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (readConcernArgs.getArgsOpTime() || readConcernArgs.getArgsAfterClusterTime() ||
+        readConcernArgs.getArgsAtClusterTime()) {
+        return false;
+    }
+
+    auto level = readConcernArgs.getLevel();
+    return level == repl::ReadConcernLevel::kLocalReadConcern ||
+        level == repl::ReadConcernLevel::kAvailableReadConcern;
+}
+
+}  // namespace
+
+AggregationResultCache::AggregationResultCache(long long maxSizeBytes)
+    : _maxSizeBytes(maxSizeBytes), _entries(std::numeric_limits<std::size_t>::max()) {}
+
+AggregationResultCache& AggregationResultCache::get(ServiceContext* serviceContext) {
+    return *getAggregationResultCache(serviceContext);
+}
+
+AggregationResultCache& AggregationResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void AggregationResultCache::set(ServiceContext* serviceContext,
+                                 std::unique_ptr<AggregationResultCache> cache) {
+    invariant(cache);
+    getAggregationResultCache(serviceContext) = std::move(cache);
+}
+
+boost::optional<std::string> AggregationResultCache::makeKey(
+    OperationContext* opCtx,
+    const NamespaceString& nss,
+    const UUID& uuid,
+    const AggregateCommandRequest& request,
+    const LiteParsedPipeline& liteParsedPipeline,
+    const BSONObj& cmdObj) {
+    if (request.getExplain() || request.getExchange() || request.getIsMapReduceCommand() ||
+        request.getRequestReshardingResumeToken() || liteParsedPipeline.hasChangeStream() ||
+        !liteParsedPipeline.getInvolvedNamespaces().empty()) {
+        return boost::none;
+    }
+
+    if (opCtx->inMultiDocumentTransaction() || !isCacheableReadConcern(opCtx)) {
+        return boost::none;
+    }
+
+    // Writes to the local database, such as oplog entries, can be made without notifying the
+    // OpObserver, so nothing would ever invalidate results cached for them.
+    if (nss.isLocal()) {
+        return boost::none;
+    }
+
+    // On a secondary, writes become visible to readers in batches after their onCommit handlers
+    // have run, so the generation no longer orders them against the reader's snapshot.
+    if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesForDatabase_UNSAFE(opCtx,
+                                                                                     nss.db())) {
+        return boost::none;
+    }
+
+    if (!isCacheablePipeline(request.getPipeline()) ||
+        (request.getLet() && !isCacheableObject(*request.getLet()))) {
+        return boost::none;
+    }
+
+    // The runtime constants attached by mongos are deliberately left out of the key; the pipeline
+    // was checked above not to reference them.
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("ns", nss.ns());
+    uuid.appendToBuilder(&keyBuilder, "uuid");
+    for (auto fieldName : {AggregateCommandRequest::kPipelineFieldName,
+                           AggregateCommandRequest::kCollationFieldName,
+                           AggregateCommandRequest::kLetFieldName,
+                           AggregateCommandRequest::kHintFieldName,
+                           AggregateCommandRequest::kCursorFieldName,
+                           AggregateCommandRequest::kNeedsMergeFieldName,
+                           AggregateCommandRequest::kFromMongosFieldName,
+                           StringData{"shardVersion"},
+                           StringData{"databaseVersion"}}) {
+        if (auto elem = cmdObj[fieldName]) {
+            keyBuilder.append(elem);
+        }
+    }
+
+    auto key = keyBuilder.done();
+    return std::string(key.objdata(), key.objsize());
+}
+
+size_t AggregationResultCache::_generationIndex(const NamespaceString& nss) {
+    return std::hash<std::string>{}(nss.ns()) % kNumGenerations;
+}
+
+AggregationResultCache::Generation AggregationResultCache::getGeneration(
+    const NamespaceString& nss) const {
+    return _generations[_generationIndex(nss)].load();
+}
+
+boost::optional<std::vector<BSONObj>> AggregationResultCache::lookup(const std::string& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        return boost::none;
+    }
+
+    if (it->second.generation != _generations[it->second.generationIndex].load()) {
+        _erase_inlock(it);
+        return boost::none;
+    }
+
+    it = _entries.promote(it);
+    return it->second.results;
+}
+
+void AggregationResultCache::insert(std::string key,
+                                    const NamespaceString& nss,
+                                    Generation generation,
+                                    std::vector<BSONObj> results) {
+    long long sizeBytes = key.size();
+    for (const auto& result : results) {
+        sizeBytes += result.objsize();
+    }
+
+    if (sizeBytes > _maxSizeBytes) {
+        return;
+    }
+
+    const auto generationIndex = _generationIndex(nss);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    // Checking the generation under the mutex orders this insert against invalidateAll().
+    if (generation != _generations[generationIndex].load()) {
+        return;
+    }
+
+    if (auto it = _entries.find(key); it != _entries.end()) {
+        _erase_inlock(it);
+    }
+
+    _entries.add(std::move(key), Entry{generationIndex, generation, std::move(results), sizeBytes});
+    _sizeBytes += sizeBytes;
+
+    while (_sizeBytes > _maxSizeBytes) {
+        _erase_inlock(std::prev(_entries.end()));
+    }
+}
+
+void AggregationResultCache::invalidate(const NamespaceString& nss) {
+    // Stale entries are erased lazily by lookup() or evicted by insert().
+    _generations[_generationIndex(nss)].fetchAndAdd(1);
+}
+
+void AggregationResultCache::invalidateAll() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto& generation : _generations) {
+        generation.fetchAndAdd(1);
+    }
+    _entries.clear();
+    _sizeBytes = 0;
+}
+
+size_t AggregationResultCache::getNumEntries() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+long long AggregationResultCache::getSizeBytes() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _sizeBytes;
+}
+
+void AggregationResultCache::_erase_inlock(LRUCache<std::string, Entry>::iterator it) {
+    _sizeBytes -= it->second.sizeBytes;
+    _entries.erase(it);
+}
+
+}  // namespace mongo
@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class AggregateCommandRequest;
+class LiteParsedPipeline;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * A bounded in-memory cache of the results of read-only aggregations on mongod.
+ *
+ * An entry is only created for a pipeline whose complete result set fit in the first batch, and is
+ * keyed on the collection UUID, the parts of the command which affect its results, and the shard
+ * and database versions attached by mongos. Each namespace hashes to a generation counter which is
+ * advanced by AggregationResultCacheOpObserver whenever a write to the namespace commits. Entries
+ * record the generation observed before the aggregation read any data and are only served while
+ * that generation is current.
+ *
+ * The cache is disabled unless the aggregationResultCacheSizeBytes server parameter is set at
+ * startup.
+ */
+class AggregationResultCache {
+    AggregationResultCache(const AggregationResultCache&) = delete;
+    AggregationResultCache& operator=(const AggregationResultCache&) = delete;
+
+public:
+    using Generation = unsigned long long;
+
+    static constexpr size_t kNumGenerations = 1024;
+
+    explicit AggregationResultCache(long long maxSizeBytes);
+
+    static AggregationResultCache& get(ServiceContext* serviceContext);
+    static AggregationResultCache& get(OperationContext* opCtx);
+    static void set(ServiceContext* serviceContext, std::unique_ptr<AggregationResultCache> cache);
+
+    /**
+     * Returns the cache key for 'request' against the collection with the given UUID, or
+     * boost::none if the results of the request must not be cached. Only pipelines made of stages
+     * whose output depends solely on the contents of 'nss' qualify, and only when they run outside
+     * of a transaction with local or available read concern on a node which accepts writes. Never
+     * caches results from the local database, whose writes can bypass the OpObserver.
+     */
+    static boost::optional<std::string> makeKey(OperationContext* opCtx,
+                                                const NamespaceString& nss,
+                                                const UUID& uuid,
+                                                const AggregateCommandRequest& request,
+                                                const LiteParsedPipeline& liteParsedPipeline,
+                                                const BSONObj& cmdObj);
+
+    bool isEnabled() const {
+        return _maxSizeBytes > 0;
+    }
+
+    /**
+     * Returns the current generation for 'nss'. Callers must obtain the generation before opening
+     * the storage snapshot their results are read from.
+     */
+    Generation getGeneration(const NamespaceString& nss) const;
+
+    /**
+     * Returns the cached results for 'key' if no write to their namespace has committed since they
+     * were computed.
+     */
+    boost::optional<std::vector<BSONObj>> lookup(const std::string& key);
+
+    /**
+     * Caches 'results' for 'key' unless a write to 'nss' has committed since 'generation' was
+     * obtained, or the results are larger than the cache itself. Least recently used entries are
+     * evicted to stay within the configured size.
+     */
+    void insert(std::string key,
+                const NamespaceString& nss,
+                Generation generation,
+                std::vector<BSONObj> results);
+
+    /**
+     * Invalidates all cached results for 'nss', and for any other namespace which shares its
+     * generation counter.
+     */
+    void invalidate(const NamespaceString& nss);
+
+    /**
+     * Invalidates every cached result.
+     */
+    void invalidateAll();
+
+    size_t getNumEntries() const;
+    long long getSizeBytes() const;
+
+private:
+    struct Entry {
+        size_t generationIndex;
+        Generation generation;
+        std::vector<BSONObj> results;
+        long long sizeBytes;
+    };
+
+    static size_t _generationIndex(const NamespaceString& nss);
+
+    void _erase_inlock(LRUCache<std::string, Entry>::iterator it);
+
+    const long long _maxSizeBytes;
+
+    // Advanced on every committed write without taking '_mutex'.
+    std::array<AtomicWord<Generation>, kNumGenerations> _generations;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("AggregationResultCache::_mutex");
+    LRUCache<std::string, Entry> _entries;
+    long long _sizeBytes = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,173 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands/aggregation_result_cache_op_observer.h"
+
+#include "mongo/db/commands/aggregation_result_cache.h"
+#include "mongo/db/concurrency/locker.h"
+#include "mongo/db/operation_context.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Invalidates the cached results for 'nss' once the current WriteUnitOfWork commits. Doing so
+ * before the commit would allow an aggregation to observe the new generation while still reading
+ * from a snapshot without the write.
+ */
+void invalidateOnCommit(OperationContext* opCtx, const NamespaceString& nss) {
+    auto& cache = AggregationResultCache::get(opCtx);
+    if (!cache.isEnabled()) {
+        return;
+    }
+
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        cache.invalidate(nss);
+        return;
+    }
+
+    opCtx->recoveryUnit()->onCommit(
+        [&cache, nss](boost::optional<Timestamp>) { cache.invalidate(nss); });
+}
+
+}  // namespace
+
+void AggregationResultCacheOpObserver::onInserts(
+    OperationContext* opCtx,
+    const NamespaceString& nss,
+    OptionalCollectionUUID uuid,
+    std::vector<InsertStatement>::const_iterator begin,
+    std::vector<InsertStatement>::const_iterator end,
+    bool fromMigrate) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void AggregationResultCacheOpObserver::onUpdate(OperationContext* opCtx,
+                                                const OplogUpdateEntryArgs& args) {
+    invalidateOnCommit(opCtx, args.nss);
+}
+
+void AggregationResultCacheOpObserver::onDelete(OperationContext* opCtx,
+                                                const NamespaceString& nss,
+                                                OptionalCollectionUUID uuid,
+                                                StmtId stmtId,
+                                                const OplogDeleteEntryArgs& args) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void AggregationResultCacheOpObserver::onCollMod(OperationContext* opCtx,
+                                                 const NamespaceString& nss,
+                                                 const UUID& uuid,
+                                                 const BSONObj& collModCmd,
+                                                 const CollectionOptions& oldCollOptions,
+                                                 boost::optional<IndexCollModInfo> indexInfo) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void AggregationResultCacheOpObserver::onDropDatabase(OperationContext* opCtx,
+                                                      const std::string& dbName) {
+    auto& cache = AggregationResultCache::get(opCtx);
+    if (cache.isEnabled()) {
+        cache.invalidateAll();
+    }
+}
+
+repl::OpTime AggregationResultCacheOpObserver::onDropCollection(
+    OperationContext* opCtx,
+    const NamespaceString& collectionName,
+    OptionalCollectionUUID uuid,
+    std::uint64_t numRecords,
+    const CollectionDropType dropType) {
+    invalidateOnCommit(opCtx, collectionName);
+    return {};
+}
+
+void AggregationResultCacheOpObserver::onDropIndex(OperationContext* opCtx,
+                                                   const NamespaceString& nss,
+                                                   OptionalCollectionUUID uuid,
+                                                   const std::string& indexName,
+                                                   const BSONObj& indexInfo) {
+    // A cached result must not be served to a request which hints the dropped index.
+    invalidateOnCommit(opCtx, nss);
+}
+
+void AggregationResultCacheOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                          const NamespaceString& fromCollection,
+                                                          const NamespaceString& toCollection,
+                                                          OptionalCollectionUUID uuid,
+                                                          OptionalCollectionUUID dropTargetUUID,
+                                                          std::uint64_t numRecords,
+                                                          bool stayTemp) {
+    invalidateOnCommit(opCtx, fromCollection);
+    invalidateOnCommit(opCtx, toCollection);
+}
+
+void AggregationResultCacheOpObserver::onImportCollection(OperationContext* opCtx,
+                                                          const UUID& importUUID,
+                                                          const NamespaceString& nss,
+                                                          long long numRecords,
+                                                          long long dataSize,
+                                                          const BSONObj& catalogEntry,
+                                                          const BSONObj& storageMetadata,
+                                                          bool isDryRun) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+repl::OpTime AggregationResultCacheOpObserver::preRenameCollection(
+    OperationContext* opCtx,
+    const NamespaceString& fromCollection,
+    const NamespaceString& toCollection,
+    OptionalCollectionUUID uuid,
+    OptionalCollectionUUID dropTargetUUID,
+    std::uint64_t numRecords,
+    bool stayTemp) {
+    invalidateOnCommit(opCtx, fromCollection);
+    invalidateOnCommit(opCtx, toCollection);
+    return {};
+}
+
+void AggregationResultCacheOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                                     const NamespaceString& collectionName,
+                                                     OptionalCollectionUUID uuid) {
+    invalidateOnCommit(opCtx, collectionName);
+}
+
+void AggregationResultCacheOpObserver::onReplicationRollback(OperationContext* opCtx,
+                                                             const RollbackObserverInfo& rbInfo) {
+    // Rolled back writes are undone without going through the OpObserver.
+    auto& cache = AggregationResultCache::get(opCtx);
+    if (cache.isEnabled()) {
+        cache.invalidateAll();
+    }
+}
+
+}  // namespace mongo
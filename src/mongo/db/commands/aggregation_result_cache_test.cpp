@@ -0,0 +1,304 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands/aggregation_result_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/aggregation_result_cache_op_observer.h"
+#include "mongo/db/pipeline/aggregation_request_helper.h"
+#include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/db/storage/write_unit_of_work.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+const NamespaceString kOtherNss("test.other");
+
+std::vector<BSONObj> makeResults(int value) {
+    return {BSON("x" << value)};
+}
+
+// Size of an entry whose key is a single character and whose results are makeResults(n).
+const long long kEntrySize = 1 + BSON("x" << 1).objsize();
+
+TEST(AggregationResultCacheTest, DisabledWhenSizeIsZero) {
+    AggregationResultCache cache(0);
+    ASSERT_FALSE(cache.isEnabled());
+
+    cache.insert("a", kNss, cache.getGeneration(kNss), makeResults(1));
+    ASSERT_FALSE(cache.lookup("a"));
+    ASSERT_EQ(0U, cache.getNumEntries());
+}
+
+TEST(AggregationResultCacheTest, LookupReturnsInsertedResults) {
+    AggregationResultCache cache(1024);
+    ASSERT_TRUE(cache.isEnabled());
+
+    cache.insert("a", kNss, cache.getGeneration(kNss), makeResults(1));
+    auto results = cache.lookup("a");
+    ASSERT_TRUE(results);
+    ASSERT_EQ(1U, results->size());
+    ASSERT_BSONOBJ_EQ(BSON("x" << 1), results->front());
+    ASSERT_EQ(1U, cache.getNumEntries());
+    ASSERT_EQ(kEntrySize, cache.getSizeBytes());
+
+    ASSERT_FALSE(cache.lookup("b"));
+}
+
+TEST(AggregationResultCacheTest, InvalidateCausesMiss) {
+    AggregationResultCache cache(1024);
+    cache.insert("a", kNss, cache.getGeneration(kNss), makeResults(1));
+
+    cache.invalidate(kNss);
+    ASSERT_FALSE(cache.lookup("a"));
+    ASSERT_EQ(0U, cache.getNumEntries());
+    ASSERT_EQ(0, cache.getSizeBytes());
+}
+
+TEST(AggregationResultCacheTest, InvalidateOtherNamespaceKeepsEntry) {
+    AggregationResultCache cache(1024);
+    if (std::hash<std::string>()(kNss.ns()) % AggregationResultCache::kNumGenerations ==
+        std::hash<std::string>()(kOtherNss.ns()) % AggregationResultCache::kNumGenerations) {
+        return;
+    }
+
+    cache.insert("a", kNss, cache.getGeneration(kNss), makeResults(1));
+    cache.invalidate(kOtherNss);
+    ASSERT_TRUE(cache.lookup("a"));
+}
+
+TEST(AggregationResultCacheTest, InsertWithStaleGenerationIsDropped) {
+    AggregationResultCache cache(1024);
+    auto generation = cache.getGeneration(kNss);
+
+    // A write committed while the results were being computed.
+    cache.invalidate(kNss);
+    cache.insert("a", kNss, generation, makeResults(1));
+    ASSERT_FALSE(cache.lookup("a"));
+    ASSERT_EQ(0U, cache.getNumEntries());
+
+    cache.insert("a", kNss, cache.getGeneration(kNss), makeResults(2));
+    ASSERT_TRUE(cache.lookup("a"));
+}
+
+TEST(AggregationResultCacheTest, EvictsLeastRecentlyUsedEntryWhenFull) {
+    AggregationResultCache cache(2 * kEntrySize);
+    cache.insert("a", kNss, cache.getGeneration(kNss), makeResults(1));
+    cache.insert("b", kNss, cache.getGeneration(kNss), makeResults(2));
+
+    // Make "a" the most recently used entry so that "b" is evicted next.
+    ASSERT_TRUE(cache.lookup("a"));
+    cache.insert("c", kNss, cache.getGeneration(kNss), makeResults(3));
+
+    ASSERT_EQ(2U, cache.getNumEntries());
+    ASSERT_EQ(2 * kEntrySize, cache.getSizeBytes());
+    ASSERT_TRUE(cache.lookup("a"));
+    ASSERT_FALSE(cache.lookup("b"));
+    ASSERT_TRUE(cache.lookup("c"));
+}
+
+TEST(AggregationResultCacheTest, ResultsLargerThanCacheAreNotCached) {
+    AggregationResultCache cache(kEntrySize);
+    cache.insert("a", kNss, cache.getGeneration(kNss), makeResults(1));
+    ASSERT_TRUE(cache.lookup("a"));
+
+    std::vector<BSONObj> largeResults{BSON("x" << 1), BSON("x" << 2)};
+    cache.insert("b", kNss, cache.getGeneration(kNss), std::move(largeResults));
+    ASSERT_FALSE(cache.lookup("b"));
+
+    // The existing entry is not evicted to make room for results which can never fit.
+    ASSERT_TRUE(cache.lookup("a"));
+}
+
+TEST(AggregationResultCacheTest, InvalidateAllClearsEveryNamespace) {
+    AggregationResultCache cache(1024);
+    auto generation = cache.getGeneration(kNss);
+    cache.insert("a", kNss, cache.getGeneration(kNss), makeResults(1));
+    cache.insert("b", kOtherNss, cache.getGeneration(kOtherNss), makeResults(2));
+
+    cache.invalidateAll();
+    ASSERT_EQ(0U, cache.getNumEntries());
+    ASSERT_EQ(0, cache.getSizeBytes());
+    ASSERT_FALSE(cache.lookup("a"));
+    ASSERT_FALSE(cache.lookup("b"));
+
+    // Results computed before the invalidation must not be cached afterwards.
+    cache.insert("a", kNss, generation, makeResults(1));
+    ASSERT_FALSE(cache.lookup("a"));
+}
+
+const UUID kUUID = UUID::gen();
+
+class AggregationResultCacheServiceTest : public ServiceContextMongoDTest {
+protected:
+    void setUp() override {
+        ServiceContextMongoDTest::setUp();
+        auto service = getServiceContext();
+
+        auto replCoord = std::make_unique<repl::ReplicationCoordinatorMock>(service);
+        _replCoord = replCoord.get();
+        repl::ReplicationCoordinator::set(service, std::move(replCoord));
+        ASSERT_OK(_replCoord->setFollowerMode(repl::MemberState::RS_PRIMARY));
+
+        AggregationResultCache::set(service, std::make_unique<AggregationResultCache>(1024));
+        _opCtx = cc().makeOperationContext();
+    }
+
+    AggregationResultCache& cache() {
+        return AggregationResultCache::get(_opCtx.get());
+    }
+
+    static BSONObj makeAggregate(const NamespaceString& nss, const BSONArray& pipeline) {
+        return BSON("aggregate" << nss.coll() << "pipeline" << pipeline << "cursor" << BSONObj()
+                                << "$db" << nss.db());
+    }
+
+    boost::optional<std::string> makeKey(const NamespaceString& nss, const BSONObj& cmdObj) {
+        auto request = aggregation_request_helper::parseFromBSON(
+            nss, cmdObj, boost::none /* explainVerbosity */, false /* apiStrict */);
+        LiteParsedPipeline liteParsedPipeline(request);
+        return AggregationResultCache::makeKey(
+            _opCtx.get(), nss, kUUID, request, liteParsedPipeline, cmdObj);
+    }
+
+    boost::optional<std::string> makeKey(const NamespaceString& nss, const BSONArray& pipeline) {
+        return makeKey(nss, makeAggregate(nss, pipeline));
+    }
+
+    repl::ReplicationCoordinatorMock* _replCoord = nullptr;
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+TEST_F(AggregationResultCacheServiceTest, MakeKeyAcceptsDeterministicPipeline) {
+    const auto pipeline = BSON_ARRAY(BSON("$match" << BSON("x" << 1))
+                                     << BSON("$group" << BSON("_id"
+                                                              << "$y")));
+    auto key = makeKey(kNss, pipeline);
+    ASSERT_TRUE(key);
+    ASSERT_EQ(*key, *makeKey(kNss, pipeline));
+
+    // Fields which do not affect the results are not part of the key.
+    auto commented = makeAggregate(kNss, pipeline).addFields(BSON("comment"
+                                                                  << "hello"));
+    ASSERT_EQ(*key, *makeKey(kNss, commented));
+
+    auto otherKey = makeKey(kNss, BSON_ARRAY(BSON("$match" << BSON("x" << 2))));
+    ASSERT_TRUE(otherKey);
+    ASSERT_NE(*key, *otherKey);
+}
+
+TEST_F(AggregationResultCacheServiceTest, MakeKeyRejectsLocalDatabase) {
+    const auto pipeline = BSON_ARRAY(BSON("$match" << BSON("x" << 1)));
+    ASSERT_FALSE(makeKey(NamespaceString::kRsOplogNamespace, pipeline));
+    ASSERT_FALSE(makeKey(NamespaceString("local.coll"), pipeline));
+}
+
+TEST_F(AggregationResultCacheServiceTest, MakeKeyRejectsNondeterministicPipelines) {
+    ASSERT_FALSE(makeKey(kNss, BSON_ARRAY(BSON("$sample" << BSON("size" << 1)))));
+    const auto randExpr = BSON("$lt" << BSON_ARRAY(BSON("$rand" << BSONObj()) << 0.5));
+    ASSERT_FALSE(makeKey(kNss, BSON_ARRAY(BSON("$match" << BSON("$expr" << randExpr)))));
+    ASSERT_FALSE(makeKey(kNss,
+                         BSON_ARRAY(BSON("$addFields" << BSON("now"
+                                                              << "$$NOW")))));
+    ASSERT_FALSE(makeKey(kNss,
+                         BSON_ARRAY(BSON("$lookup" << BSON("from"
+                                                           << "other"
+                                                           << "localField"
+                                                           << "a"
+                                                           << "foreignField"
+                                                           << "b"
+                                                           << "as"
+                                                           << "c")))));
+}
+
+TEST_F(AggregationResultCacheServiceTest, MakeKeyRejectsNonLocalReadConcern) {
+    repl::ReadConcernArgs::get(_opCtx.get()) =
+        repl::ReadConcernArgs(repl::ReadConcernLevel::kMajorityReadConcern);
+    ASSERT_FALSE(makeKey(kNss, BSON_ARRAY(BSON("$match" << BSON("x" << 1)))));
+}
+
+TEST_F(AggregationResultCacheServiceTest, MakeKeyRejectsTransactions) {
+    _opCtx->setInMultiDocumentTransaction();
+    ASSERT_FALSE(makeKey(kNss, BSON_ARRAY(BSON("$match" << BSON("x" << 1)))));
+}
+
+TEST_F(AggregationResultCacheServiceTest, MakeKeyRejectsSecondaries) {
+    ASSERT_OK(_replCoord->setFollowerMode(repl::MemberState::RS_SECONDARY));
+    ASSERT_FALSE(makeKey(kNss, BSON_ARRAY(BSON("$match" << BSON("x" << 1)))));
+}
+
+TEST_F(AggregationResultCacheServiceTest, OpObserverInvalidatesOnlyOnCommit) {
+    AggregationResultCacheOpObserver opObserver;
+    std::vector<InsertStatement> inserts{InsertStatement(BSON("_id" << 1))};
+
+    auto generation = cache().getGeneration(kNss);
+    {
+        WriteUnitOfWork wuow(_opCtx.get());
+        opObserver.onInserts(_opCtx.get(), kNss, kUUID, inserts.begin(), inserts.end(), false);
+        // Readers of the pre-write snapshot may still cache their results until the commit.
+        ASSERT_EQ(generation, cache().getGeneration(kNss));
+        wuow.commit();
+    }
+    ASSERT_NE(generation, cache().getGeneration(kNss));
+
+    generation = cache().getGeneration(kNss);
+    {
+        WriteUnitOfWork wuow(_opCtx.get());
+        opObserver.onInserts(_opCtx.get(), kNss, kUUID, inserts.begin(), inserts.end(), false);
+    }
+    ASSERT_EQ(generation, cache().getGeneration(kNss));
+}
+
+TEST_F(AggregationResultCacheServiceTest, OpObserverInvalidatesCachedResults) {
+    AggregationResultCacheOpObserver opObserver;
+    const auto deletedDoc = BSON("_id" << 1);
+    OpObserver::OplogDeleteEntryArgs deleteArgs;
+    deleteArgs.deletedDoc = &deletedDoc;
+
+    cache().insert("a", kNss, cache().getGeneration(kNss), makeResults(1));
+    opObserver.onDelete(_opCtx.get(), kNss, kUUID, kUninitializedStmtId, deleteArgs);
+    ASSERT_FALSE(cache().lookup("a"));
+
+    cache().insert("a", kNss, cache().getGeneration(kNss), makeResults(1));
+    cache().insert("b", kOtherNss, cache().getGeneration(kOtherNss), makeResults(2));
+    opObserver.onDropDatabase(_opCtx.get(), kNss.db().toString());
+    ASSERT_EQ(0U, cache().getNumEntries());
+}
+
+}  // namespace
+}  // namespace mongo
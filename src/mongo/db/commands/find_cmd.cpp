@@ -50,6 +50,7 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/point_read_coalescer.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
@@ -376,6 +377,38 @@ public:
             // Although it is a command, a find command gets counted as a query.
             globalOpCounters.gotQuery();
 
+            auto coalescingKey = makePointReadCoalescingKey(opCtx, _request.body);
+            if (!coalescingKey) {
+                _runFind(opCtx, result, [] {});
+                return;
+            }
+
+            auto sharedReply = PointReadCoalescer::get(opCtx)->runOrJoin(
+                opCtx,
+                *coalescingKey,
+                [&](const PointReadCoalescer::StopJoiningFn& stopJoining)
+                    -> boost::optional<BSONObj> {
+                    _runFind(opCtx, result, stopJoining);
+
+                    // Only replies which exhausted the results can be handed out more than once.
+                    auto reply = result->getBodyBuilder().asTempObj();
+                    if (reply["cursor"]["id"].safeNumberLong() != 0) {
+                        return boost::none;
+                    }
+                    return reply.getOwned();
+                });
+            if (sharedReply) {
+                result->getBodyBuilder().appendElements(*sharedReply);
+            }
+        }
+
+        /**
+         * Executes this find and writes its reply to 'result'. Calls 'beforeOpeningSnapshot' before
+         * acquiring the collection, which is no later than the storage snapshot being opened.
+         */
+        void _runFind(OperationContext* opCtx,
+                      rpc::ReplyBuilderInterface* result,
+                      const std::function<void()>& beforeOpeningSnapshot) {
             const BSONObj& cmdObj = _request.body;
 
             // Parse the command BSON to a FindCommandRequest. Pass in the parsedNss in case cmdObj
@@ -422,6 +455,7 @@ public:
 
             // Acquire locks. If the query is on a view, we release our locks and convert the query
             // request into an aggregation command.
+            beforeOpeningSnapshot();
             boost::optional<AutoGetCollectionForReadCommandMaybeLockFree> ctx;
             ctx.emplace(opCtx,
                         CommandHelpers::parseNsOrUUID(_dbName, _request.body),
@@ -0,0 +1,49 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/util/concurrency/admission_priority.h"
+
+namespace mongo {
+
+class NamespaceString;
+class OperationContext;
+
+/**
+ * Returns the queue a getMore on 'nss' joins when it has to wait for a ticket. Getmores on exhaust
+ * cursors from applications stream a whole result set back to back, so they wait behind
+ * interactive operations. Exhaust cursors opened by other members of the cluster, such as the
+ * oplog fetcher and the initial sync cloners, keep normal priority because the low priority queue
+ * is only served once the normal one is empty, and replication must not starve while client reads
+ * saturate the tickets.
+ */
+AdmissionPriority getMoreAdmissionPriority(OperationContext* opCtx, const NamespaceString& nss);
+
+}  // namespace mongo
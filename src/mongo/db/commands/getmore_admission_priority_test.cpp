@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands/getmore_admission_priority.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/mock_session.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+class GetMoreAdmissionPriorityTest : public ServiceContextTest {
+protected:
+    /**
+     * Returns the priority of an exhaust getMore on 'nss' from a connection whose session carries
+     * 'tags'.
+     */
+    AdmissionPriority exhaustPriority(transport::Session::TagMask tags,
+                                      const NamespaceString& nss = kNss) {
+        auto session = transport::MockSession::create(nullptr);
+        session->setTags(tags);
+        auto client = getServiceContext()->makeClient("getMoreAdmissionPriority", session);
+        auto opCtx = client->makeOperationContext();
+        opCtx->setExhaust(true);
+        return getMoreAdmissionPriority(opCtx.get(), nss);
+    }
+};
+
+TEST_F(GetMoreAdmissionPriorityTest, NonExhaustGetMoresHaveNormalPriority) {
+    auto session = transport::MockSession::create(nullptr);
+    auto client = getServiceContext()->makeClient("getMoreAdmissionPriority", session);
+    auto opCtx = client->makeOperationContext();
+    ASSERT_EQ(AdmissionPriority::kNormal, getMoreAdmissionPriority(opCtx.get(), kNss));
+}
+
+TEST_F(GetMoreAdmissionPriorityTest, ExhaustGetMoresFromApplicationsHaveLowPriority) {
+    ASSERT_EQ(AdmissionPriority::kLow, exhaustPriority(transport::Session::kEmptyTagMask));
+}
+
+TEST_F(GetMoreAdmissionPriorityTest, ExhaustGetMoresFromInternalClientsHaveNormalPriority) {
+    ASSERT_EQ(AdmissionPriority::kNormal, exhaustPriority(transport::Session::kInternalClient));
+
+    // Operations without a session are run by the server itself.
+    auto opCtx = makeOperationContext();
+    opCtx->setExhaust(true);
+    ASSERT_EQ(AdmissionPriority::kNormal, getMoreAdmissionPriority(opCtx.get(), kNss));
+}
+
+TEST_F(GetMoreAdmissionPriorityTest, ExhaustGetMoresOnTheOplogHaveNormalPriority) {
+    ASSERT_EQ(
+        AdmissionPriority::kNormal,
+        exhaustPriority(transport::Session::kEmptyTagMask, NamespaceString::kRsOplogNamespace));
+}
+
+TEST_F(GetMoreAdmissionPriorityTest, InternalExhaustGetMoreIsNotQueuedBehindNormalWaiters) {
+    TicketHolder holder(1);
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> order;
+    std::vector<stdx::thread> threads;
+
+    auto startWaiter = [&](AdmissionPriority priority, std::string name) {
+        threads.emplace_back([&, priority, name] {
+            holder.waitForTicket(nullptr, priority);
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                order.push_back(name);
+            }
+            holder.release();
+        });
+    };
+    auto waitForQueued = [&](AdmissionPriority priority, int expected) {
+        while (holder.queued(priority) != expected) {
+            sleepmillis(1);
+        }
+    };
+
+    // The internal getMore joins the normal queue, so it is admitted in arrival order with other
+    // normal waiters and ahead of the exhaust getMore of an application that arrived before it.
+    ASSERT(holder.tryAcquire());
+    startWaiter(exhaustPriority(transport::Session::kEmptyTagMask), "application");
+    waitForQueued(AdmissionPriority::kLow, 1);
+    startWaiter(exhaustPriority(transport::Session::kInternalClient), "internal");
+    waitForQueued(AdmissionPriority::kNormal, 1);
+    startWaiter(AdmissionPriority::kNormal, "normal");
+    waitForQueued(AdmissionPriority::kNormal, 2);
+
+    holder.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE((order == std::vector<std::string>{"internal", "normal", "application"}));
+}
+
+}  // namespace
+}  // namespace mongo
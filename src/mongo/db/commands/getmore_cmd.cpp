@@ -44,6 +44,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/getmore_admission_priority.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/cursor_manager.h"
@@ -415,6 +416,12 @@ public:
             boost::optional<AutoGetCollectionForReadMaybeLockFree> readLock;
             boost::optional<AutoStatsTracker> statsTracker;
             NamespaceString nss(_cmd.getDbName(), _cmd.getCollection());
+
+            // Exhaust getMores from applications queue behind interactive operations when read
+            // tickets run out.
+            if (getMoreAdmissionPriority(opCtx, nss) == AdmissionPriority::kLow) {
+                opCtx->lockState()->setAdmissionPriority(AdmissionPriority::kLow);
+            }
             int64_t cursorId = _cmd.getCommandParameter();
 
             // Setup OperationContext state for this operation which will set the correct read
@@ -41,6 +41,7 @@
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/commands/aggregation_result_cache.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/db_raii.h"
@@ -124,7 +125,8 @@ bool handleCursorCommand(OperationContext* opCtx,
                          std::vector<ClientCursor*> cursors,
                          const AggregateCommandRequest& request,
                          const BSONObj& cmdObj,
-                         rpc::ReplyBuilderInterface* result) {
+                         rpc::ReplyBuilderInterface* result,
+                         std::vector<BSONObj>* resultsToCache) {
     invariant(!cursors.empty());
     long long batchSize =
         request.getCursor().getBatchSize().value_or(aggregation_request_helper::kDefaultBatchSize);
@@ -246,6 +248,9 @@ bool handleCursorCommand(OperationContext* opCtx,
         responseBuilder.setPostBatchResumeToken(exec->getPostBatchResumeToken());
         responseBuilder.append(nextDoc);
         docUnitsReturned.observeOne(nextDoc.objsize());
+        if (resultsToCache) {
+            resultsToCache->push_back(nextDoc.getOwned());
+        }
     }
 
     if (cursor) {
@@ -279,6 +284,37 @@ bool handleCursorCommand(OperationContext* opCtx,
     return static_cast<bool>(cursor);
 }
 
+/**
+ * Replies to an aggregate command with results served from the AggregationResultCache. The cached
+ * results are always a complete result set, so no cursor is established.
+ */
+void handleCachedResults(OperationContext* opCtx,
+                         const NamespaceString& nsForCursor,
+                         const std::vector<BSONObj>& cachedResults,
+                         rpc::ReplyBuilderInterface* result) {
+    CursorResponseBuilder::Options options;
+    options.isInitialResponse = true;
+    CursorResponseBuilder responseBuilder(result, options);
+
+    ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+    for (const auto& doc : cachedResults) {
+        responseBuilder.append(doc);
+        docUnitsReturned.observeOne(doc.objsize());
+    }
+    responseBuilder.done(0LL, nsForCursor.ns());
+
+    auto curOp = CurOp::get(opCtx);
+    curOp->debug().cursorExhausted = true;
+    curOp->debug().nreturned = cachedResults.size();
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        curOp->setPlanSummary_inlock("CACHED_RESULT"_sd);
+    }
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
+    metricsCollector.incrementDocUnitsReturned(docUnitsReturned);
+}
+
 StatusWith<StringMap<ExpressionContext::ResolvedNamespace>> resolveInvolvedNamespaces(
     OperationContext* opCtx, const AggregateCommandRequest& request) {
     const LiteParsedPipeline liteParsedPipeline(request);
@@ -594,6 +630,14 @@ Status runAggregate(OperationContext* opCtx,
     std::vector<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> execs;
     boost::intrusive_ptr<ExpressionContext> expCtx;
     auto curOp = CurOp::get(opCtx);
+
+    // The result cache generation must be read before the storage snapshot is opened so that any
+    // write committed while the pipeline runs prevents its results from being cached.
+    auto& resultCache = AggregationResultCache::get(opCtx);
+    const bool canUseResultCache =
+        resultCache.isEnabled() && !opCtx->recoveryUnit()->isActive();
+    const auto resultCacheGeneration = canUseResultCache ? resultCache.getGeneration(nss) : 0;
+    boost::optional<std::string> resultCacheKey;
     {
         // If we are in a transaction, check whether the parsed pipeline supports
         // being in a transaction.
@@ -760,6 +804,18 @@ Status runAggregate(OperationContext* opCtx,
                     uuid && uuid == *request.getCollectionUUID());
         }
 
+        if (canUseResultCache && ctx && uuid) {
+            resultCacheKey = AggregationResultCache::makeKey(
+                opCtx, nss, *uuid, request, liteParsedPipeline, cmdObj);
+            if (resultCacheKey) {
+                if (auto cachedResults = resultCache.lookup(*resultCacheKey)) {
+                    liteParsedPipeline.tickGlobalStageCounters();
+                    handleCachedResults(opCtx, origNss, *cachedResults, result);
+                    return Status::OK();
+                }
+            }
+        }
+
         invariant(collatorToUse);
         expCtx = makeExpressionContext(
             opCtx, request, std::move(*collatorToUse), uuid, collatorToUseMatchesDefault);
@@ -916,10 +972,22 @@ Status runAggregate(OperationContext* opCtx,
         }
     } else {
         // Cursor must be specified, if explain is not.
-        const bool keepCursor = handleCursorCommand(
-            opCtx, expCtx, origNss, std::move(cursors), request, cmdObj, result);
+        std::vector<BSONObj> resultsToCache;
+        const bool keepCursor = handleCursorCommand(opCtx,
+                                                    expCtx,
+                                                    origNss,
+                                                    std::move(cursors),
+                                                    request,
+                                                    cmdObj,
+                                                    result,
+                                                    resultCacheKey ? &resultsToCache : nullptr);
         if (keepCursor) {
             cursorFreer.dismiss();
+        } else if (resultCacheKey) {
+            resultCache.insert(std::move(*resultCacheKey),
+                               nss,
+                               resultCacheGeneration,
+                               std::move(resultsToCache));
         }
 
         PlanSummaryStats stats;
@@ -165,6 +165,29 @@ public:
         return builder.obj();
     }
 } tlsVersionStatus;
+
+/**
+ * Status section counting TLS handshakes which resumed a cached session instead of performing a
+ * full handshake, split by whether this process accepted or initiated the connection.
+ */
+class TLSSessionResumptionStatus : public ServerStatusSection {
+public:
+    TLSSessionResumptionStatus() : ServerStatusSection("tlsSessionResumption") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        auto& counts = TLSSessionResumptionCounts::get(opCtx->getServiceContext());
+
+        BSONObjBuilder builder;
+        builder.append("ingress", counts.ingress.load());
+        builder.append("egress", counts.egress.load());
+        return builder.obj();
+    }
+} tlsSessionResumptionStatus;
 #endif
 
 class AdvisoryHostFQDNs final : public ServerStatusSection {
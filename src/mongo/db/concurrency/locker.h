@@ -37,6 +37,7 @@
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/admission_priority.h"
 
 namespace mongo {
 
@@ -506,6 +507,18 @@ public:
         return _shouldAcquireTicket;
     }
 
+    /**
+     * Selects the queue this locker waits in when no ticket is available. Bulk work that should
+     * give way to interactive operations under load uses AdmissionPriority::kLow.
+     */
+    void setAdmissionPriority(AdmissionPriority priority) {
+        _admissionPriority = priority;
+    }
+
+    AdmissionPriority getAdmissionPriority() const {
+        return _admissionPriority;
+    }
+
     /**
      * Acquire a flow control admission ticket into the system. Flow control is used as a
      * backpressure mechanism to limit replication majority point lag.
@@ -555,6 +568,7 @@ private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
     bool _shouldAllowLockAcquisitionOnTimestampedUnitOfWork = false;
     bool _shouldAcquireTicket = true;
+    AdmissionPriority _admissionPriority = AdmissionPriority::kNormal;
     std::string _debugInfo;  // Extra info about this locker for debugging purpose
 };
 
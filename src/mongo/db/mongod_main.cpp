@@ -66,6 +66,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/client_metadata_propagation_egress_hook.h"
 #include "mongo/db/clientcursor.h"
+#include "mongo/db/commands/aggregation_result_cache_op_observer.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
 #include "mongo/db/commands/feature_compatibility_version_gen.h"
 #include "mongo/db/commands/shutdown.h"
@@ -1098,6 +1099,7 @@ void setUpObservers(ServiceContext* serviceContext) {
     opObserverRegistry->addObserver(
         std::make_unique<repl::PrimaryOnlyServiceOpObserver>(serviceContext));
     opObserverRegistry->addObserver(std::make_unique<FcvOpObserver>());
+    opObserverRegistry->addObserver(std::make_unique<AggregationResultCacheOpObserver>());
 
     setupFreeMonitoringOpObserver(opObserverRegistry.get());
 
@@ -0,0 +1,186 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/point_read_coalescer.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/point_read_coalescer_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+MONGO_FAIL_POINT_DEFINE(hangBeforePointReadLeaderExecutes);
+MONGO_FAIL_POINT_DEFINE(hangAfterJoiningPointRead);
+
+const auto getPointReadCoalescer = ServiceContext::declareDecoration<PointReadCoalescer>();
+
+// Requests that executed while other identical requests could join them.
+Counter64 coalescingLeaders;
+// Requests that were answered with the reply of an identical in-flight request.
+Counter64 coalescingHits;
+// Requests that waited for an identical request but had to execute on their own.
+Counter64 coalescingFallbacks;
+
+ServerStatusMetricField<Counter64> displayCoalescingLeaders("query.pointReadCoalescing.leaders",
+                                                            &coalescingLeaders);
+ServerStatusMetricField<Counter64> displayCoalescingHits("query.pointReadCoalescing.hits",
+                                                         &coalescingHits);
+ServerStatusMetricField<Counter64> displayCoalescingFallbacks(
+    "query.pointReadCoalescing.fallbacks", &coalescingFallbacks);
+
+}  // namespace
+
+PointReadCoalescer* PointReadCoalescer::get(ServiceContext* serviceContext) {
+    return &getPointReadCoalescer(serviceContext);
+}
+
+PointReadCoalescer* PointReadCoalescer::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+boost::optional<BSONObj> PointReadCoalescer::runOrJoin(OperationContext* opCtx,
+                                                       const BSONObj& key,
+                                                       const ExecuteFn& execute) {
+    auto flight = std::make_shared<Flight>();
+    std::shared_ptr<Flight> leader;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto [it, inserted] = _inFlight.emplace(key.getOwned(), flight);
+        if (!inserted) {
+            leader = it->second;
+        }
+    }
+
+    if (leader) {
+        hangAfterJoiningPointRead.pauseWhileSet(opCtx);
+
+        auto swReply = leader->getFuture().getNoThrow(opCtx);
+        if (swReply.isOK()) {
+            coalescingHits.increment();
+            return std::move(swReply.getValue());
+        }
+
+        // Only an interruption of this operation is reported to the caller; any other failure
+        // belongs to the leader, so execute this request on its own.
+        opCtx->checkForInterrupt();
+        coalescingFallbacks.increment();
+        execute([] {});
+        return boost::none;
+    }
+
+    coalescingLeaders.increment();
+    auto releaseFollowers = makeGuard([&] { _finish(key, flight, boost::none); });
+    hangBeforePointReadLeaderExecutes.pauseWhileSet(opCtx);
+    auto reply = execute([&] { _stopJoining(key, flight); });
+    releaseFollowers.dismiss();
+    _finish(key, flight, std::move(reply));
+    return boost::none;
+}
+
+size_t PointReadCoalescer::numInFlight() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _inFlight.size();
+}
+
+void PointReadCoalescer::_stopJoining(const BSONObj& key, const std::shared_ptr<Flight>& flight) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    // A newer leader may already be registered under the same key once this one stopped accepting
+    // followers, so only unregister the flight if it is still this leader's.
+    auto it = _inFlight.find(key);
+    if (it != _inFlight.end() && it->second == flight) {
+        _inFlight.erase(it);
+    }
+}
+
+void PointReadCoalescer::_finish(const BSONObj& key,
+                                 const std::shared_ptr<Flight>& flight,
+                                 boost::optional<BSONObj> reply) {
+    // Unregister before waking the followers, in case the leader never reached its read.
+    _stopJoining(key, flight);
+
+    if (reply) {
+        flight->emplaceValue(reply->getOwned());
+    } else {
+        flight->setError({ErrorCodes::QueryPlanKilled,
+                          "Coalesced request did not produce a shareable reply"});
+    }
+}
+
+boost::optional<BSONObj> makePointReadCoalescingKey(OperationContext* opCtx,
+                                                    const BSONObj& findCmd) {
+    static const StringDataSet kPerRequestFields{"lsid",
+                                                 "$clusterTime",
+                                                 "$configTime",
+                                                 "$topologyTime",
+                                                 "$configServerState",
+                                                 "comment",
+                                                 "clientOperationKey",
+                                                 "maxTimeMS",
+                                                 "readConcern"};
+
+    if (!gCoalesceIdenticalPointReads.load() || opCtx->inMultiDocumentTransaction() ||
+        opCtx->getTxnNumber() || opCtx->isExhaust() || opCtx->getClient()->isInDirectClient()) {
+        return boost::none;
+    }
+
+    const auto filter = findCmd["filter"];
+    if (filter.type() != BSONType::Object || !CanonicalQuery::isSimpleIdQuery(filter.Obj()) ||
+        findCmd.hasField("term") || findCmd["tailable"].trueValue()) {
+        return boost::none;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (readConcernArgs.getLevel() == repl::ReadConcernLevel::kLinearizableReadConcern) {
+        return boost::none;
+    }
+
+    BSONObjBuilder keyBuilder;
+    for (auto&& elem : findCmd) {
+        if (!kPerRequestFields.contains(elem.fieldNameStringData())) {
+            keyBuilder.append(elem);
+        }
+    }
+    keyBuilder.appendElements(readConcernArgs.toBSON());
+    return keyBuilder.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <functional>
+#include <memory>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/future.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Lets identical read-only requests that arrive while one of them is executing share its reply
+ * instead of each running the full command path ("single-flight"). The first request for a given
+ * key becomes the leader and executes; requests with the same key that arrive before the leader
+ * finishes wait for it and reuse its reply. A follower whose leader fails, or produces a reply that
+ * cannot be shared, executes on its own.
+ *
+ * The key must capture everything that can influence the reply, including the read concern.
+ * Followers can only join a leader until it opens the storage snapshot its reply is read from, so
+ * a follower never observes a snapshot older than its own arrival, and writes acknowledged to its
+ * client before it arrived remain visible.
+ */
+class PointReadCoalescer {
+    PointReadCoalescer(const PointReadCoalescer&) = delete;
+    PointReadCoalescer& operator=(const PointReadCoalescer&) = delete;
+
+public:
+    /**
+     * Invoked by a leader right before it opens the storage snapshot its reply is read from. From
+     * then on, requests with the same key no longer join it.
+     */
+    using StopJoiningFn = std::function<void()>;
+
+    /**
+     * Produces the reply for the calling request, calling 'stopJoining' before opening its storage
+     * snapshot. Returns the copy of the reply that may be handed to followers, or boost::none if
+     * it must not be shared.
+     */
+    using ExecuteFn = std::function<boost::optional<BSONObj>(const StopJoiningFn& stopJoining)>;
+
+    PointReadCoalescer() = default;
+
+    static PointReadCoalescer* get(ServiceContext* serviceContext);
+    static PointReadCoalescer* get(OperationContext* opCtx);
+
+    /**
+     * Returns the reply of an identical in-flight request for 'key' if there is one and it
+     * completes with a shareable reply. Otherwise calls 'execute' and returns boost::none. Errors
+     * thrown by 'execute' and interruptions of 'opCtx' while waiting propagate to the caller.
+     */
+    boost::optional<BSONObj> runOrJoin(OperationContext* opCtx,
+                                       const BSONObj& key,
+                                       const ExecuteFn& execute);
+
+    /**
+     * Returns the number of leaders that followers can currently join. Used for testing.
+     */
+    size_t numInFlight() const;
+
+private:
+    using Flight = SharedPromise<BSONObj>;
+
+    void _stopJoining(const BSONObj& key, const std::shared_ptr<Flight>& flight);
+
+    void _finish(const BSONObj& key,
+                 const std::shared_ptr<Flight>& flight,
+                 boost::optional<BSONObj> reply);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("PointReadCoalescer::_mutex");
+
+    // Leaders that have not yet opened their storage snapshot, keyed by the request key.
+    SimpleBSONObjUnorderedMap<std::shared_ptr<Flight>> _inFlight;
+};
+
+/**
+ * Returns the key under which the find command 'findCmd' may share its reply with identical
+ * concurrent finds, or boost::none if it must execute on its own. Only point reads by _id outside
+ * of transactions are coalesced. The key is the command without the fields that vary between
+ * otherwise identical requests, plus the effective read concern.
+ */
+boost::optional<BSONObj> makePointReadCoalescingKey(OperationContext* opCtx,
+                                                    const BSONObj& findCmd);
+
+}  // namespace mongo
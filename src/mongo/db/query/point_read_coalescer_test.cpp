@@ -0,0 +1,369 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/point_read_coalescer.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/logical_session_id.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+using StopJoiningFn = PointReadCoalescer::StopJoiningFn;
+using Reply = boost::optional<BSONObj>;
+
+const BSONObj kKey = BSON("find"
+                          << "coll"
+                          << "filter" << BSON("_id" << 1) << "$db"
+                          << "test");
+const BSONObj kReply =
+    BSON("cursor" << BSON("id" << 0LL << "firstBatch" << BSON_ARRAY(BSON("_id" << 1))));
+
+class PointReadCoalescerTest : public ServiceContextTest {
+protected:
+    PointReadCoalescer* coalescer() {
+        return PointReadCoalescer::get(getServiceContext());
+    }
+
+    /**
+     * Runs a request for 'key' on a separate thread while the calling thread's request for the
+     * same key is executing, and returns once it has joined the executing request.
+     */
+    stdx::thread startFollower(OperationContext* opCtx,
+                               const BSONObj& key,
+                               boost::optional<BSONObj>* reply,
+                               bool* executed,
+                               Status* status) {
+        stdx::thread follower([=] {
+            try {
+                *reply = coalescer()->runOrJoin(opCtx, key, [=](const StopJoiningFn&) -> Reply {
+                    *executed = true;
+                    return boost::none;
+                });
+            } catch (const DBException& ex) {
+                *status = ex.toStatus();
+            }
+        });
+
+        while (!opCtx->isWaitingForConditionOrInterrupt()) {
+            sleepmillis(1);
+        }
+        return follower;
+    }
+};
+
+TEST_F(PointReadCoalescerTest, FollowerReusesLeaderReply) {
+    auto leaderOpCtx = makeOperationContext();
+    auto followerClient = getServiceContext()->makeClient("follower");
+    auto followerOpCtx = followerClient->makeOperationContext();
+
+    boost::optional<BSONObj> followerReply;
+    bool followerExecuted = false;
+    Status followerStatus = Status::OK();
+    stdx::thread follower;
+
+    auto leaderReply =
+        coalescer()->runOrJoin(leaderOpCtx.get(), kKey, [&](const StopJoiningFn&) -> Reply {
+            ASSERT_EQ(1U, coalescer()->numInFlight());
+            follower = startFollower(
+                followerOpCtx.get(), kKey, &followerReply, &followerExecuted, &followerStatus);
+            return kReply;
+        });
+    follower.join();
+
+    ASSERT_FALSE(leaderReply);
+    ASSERT_OK(followerStatus);
+    ASSERT_FALSE(followerExecuted);
+    ASSERT(followerReply);
+    ASSERT_BSONOBJ_EQ(kReply, *followerReply);
+    ASSERT_EQ(0U, coalescer()->numInFlight());
+}
+
+TEST_F(PointReadCoalescerTest, FollowerExecutesWhenReplyIsNotShareable) {
+    auto leaderOpCtx = makeOperationContext();
+    auto followerClient = getServiceContext()->makeClient("follower");
+    auto followerOpCtx = followerClient->makeOperationContext();
+
+    boost::optional<BSONObj> followerReply;
+    bool followerExecuted = false;
+    Status followerStatus = Status::OK();
+    stdx::thread follower;
+
+    coalescer()->runOrJoin(leaderOpCtx.get(), kKey, [&](const StopJoiningFn&) -> Reply {
+        follower = startFollower(
+            followerOpCtx.get(), kKey, &followerReply, &followerExecuted, &followerStatus);
+        return boost::none;
+    });
+    follower.join();
+
+    ASSERT_OK(followerStatus);
+    ASSERT_TRUE(followerExecuted);
+    ASSERT_FALSE(followerReply);
+}
+
+TEST_F(PointReadCoalescerTest, FollowerExecutesWhenLeaderThrows) {
+    auto leaderOpCtx = makeOperationContext();
+    auto followerClient = getServiceContext()->makeClient("follower");
+    auto followerOpCtx = followerClient->makeOperationContext();
+
+    boost::optional<BSONObj> followerReply;
+    bool followerExecuted = false;
+    Status followerStatus = Status::OK();
+    stdx::thread follower;
+
+    ASSERT_THROWS_CODE(
+        coalescer()->runOrJoin(leaderOpCtx.get(),
+                               kKey,
+                               [&](const StopJoiningFn&) -> Reply {
+                                   follower = startFollower(followerOpCtx.get(),
+                                                            kKey,
+                                                            &followerReply,
+                                                            &followerExecuted,
+                                                            &followerStatus);
+                                   uasserted(ErrorCodes::StaleConfig, "leader failed");
+                               }),
+        DBException,
+        ErrorCodes::StaleConfig);
+    follower.join();
+
+    ASSERT_OK(followerStatus);
+    ASSERT_TRUE(followerExecuted);
+    ASSERT_EQ(0U, coalescer()->numInFlight());
+}
+
+TEST_F(PointReadCoalescerTest, InterruptedFollowerDoesNotExecute) {
+    auto leaderOpCtx = makeOperationContext();
+    auto followerClient = getServiceContext()->makeClient("follower");
+    auto followerOpCtx = followerClient->makeOperationContext();
+
+    boost::optional<BSONObj> followerReply;
+    bool followerExecuted = false;
+    Status followerStatus = Status::OK();
+    stdx::thread follower;
+
+    coalescer()->runOrJoin(leaderOpCtx.get(), kKey, [&](const StopJoiningFn&) -> Reply {
+        follower = startFollower(
+            followerOpCtx.get(), kKey, &followerReply, &followerExecuted, &followerStatus);
+        {
+            stdx::lock_guard<Client> lk(*followerClient);
+            followerOpCtx->markKilled(ErrorCodes::Interrupted);
+        }
+        follower.join();
+        return kReply;
+    });
+
+    ASSERT_EQ(ErrorCodes::Interrupted, followerStatus);
+    ASSERT_FALSE(followerExecuted);
+    ASSERT_FALSE(followerReply);
+}
+
+TEST_F(PointReadCoalescerTest, DifferentKeysAreNotCoalesced) {
+    auto opCtx = makeOperationContext();
+    const auto otherKey = kKey.addFields(BSON("filter" << BSON("_id" << 2)));
+
+    bool otherExecuted = false;
+    coalescer()->runOrJoin(opCtx.get(), kKey, [&](const StopJoiningFn&) -> Reply {
+        auto otherReply =
+            coalescer()->runOrJoin(opCtx.get(), otherKey, [&](const StopJoiningFn&) -> Reply {
+                ASSERT_EQ(2U, coalescer()->numInFlight());
+                otherExecuted = true;
+                return kReply;
+            });
+        ASSERT_FALSE(otherReply);
+        return kReply;
+    });
+
+    ASSERT_TRUE(otherExecuted);
+    ASSERT_EQ(0U, coalescer()->numInFlight());
+}
+
+TEST_F(PointReadCoalescerTest, RequestsDoNotJoinLeaderThatStoppedJoining) {
+    auto opCtx = makeOperationContext();
+
+    bool secondExecuted = false;
+    coalescer()->runOrJoin(opCtx.get(), kKey, [&](const StopJoiningFn& stopJoining) {
+        stopJoining();
+        ASSERT_EQ(0U, coalescer()->numInFlight());
+
+        // The leader may now read a snapshot older than this request, so it executes on its own.
+        auto secondReply = coalescer()->runOrJoin(opCtx.get(), kKey, [&](const StopJoiningFn&) {
+            ASSERT_EQ(1U, coalescer()->numInFlight());
+            secondExecuted = true;
+            return Reply(kReply);
+        });
+        ASSERT_FALSE(secondReply);
+        return Reply(kReply);
+    });
+
+    ASSERT_TRUE(secondExecuted);
+    ASSERT_EQ(0U, coalescer()->numInFlight());
+}
+
+TEST_F(PointReadCoalescerTest, FinishingLeaderKeepsNewerLeaderForSameKey) {
+    auto firstOpCtx = makeOperationContext();
+    auto secondClient = getServiceContext()->makeClient("second");
+    auto secondOpCtx = secondClient->makeOperationContext();
+
+    Notification<void> secondExecuting;
+    Notification<void> firstFinished;
+    stdx::thread second;
+
+    coalescer()->runOrJoin(firstOpCtx.get(), kKey, [&](const StopJoiningFn& stopJoining) {
+        stopJoining();
+        second = stdx::thread([&] {
+            coalescer()->runOrJoin(secondOpCtx.get(), kKey, [&](const StopJoiningFn&) {
+                secondExecuting.set();
+                firstFinished.get();
+                return Reply(kReply);
+            });
+        });
+        secondExecuting.get();
+        return Reply(kReply);
+    });
+
+    // The second request still accepts followers after the first one is done.
+    ASSERT_EQ(1U, coalescer()->numInFlight());
+    firstFinished.set();
+    second.join();
+    ASSERT_EQ(0U, coalescer()->numInFlight());
+}
+
+class PointReadCoalescingKeyTest : public ServiceContextTest {
+protected:
+    void setUp() override {
+        ServiceContextTest::setUp();
+        _opCtx = makeOperationContext();
+    }
+
+    OperationContext* opCtx() {
+        return _opCtx.get();
+    }
+
+    boost::optional<BSONObj> makeKey(const BSONObj& findCmd) {
+        return makePointReadCoalescingKey(opCtx(), findCmd);
+    }
+
+private:
+    RAIIServerParameterControllerForTest _coalesceIdenticalPointReads{
+        "coalesceIdenticalPointReads", true};
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+TEST_F(PointReadCoalescingKeyTest, AcceptsPointReadById) {
+    auto key = makeKey(kKey);
+    ASSERT(key);
+    ASSERT_BSONOBJ_EQ(kKey.addFields(repl::ReadConcernArgs::get(opCtx()).toBSON()), *key);
+}
+
+TEST_F(PointReadCoalescingKeyTest, RejectsWhenDisabled) {
+    RAIIServerParameterControllerForTest coalesce{"coalesceIdenticalPointReads", false};
+    ASSERT_FALSE(makeKey(kKey));
+}
+
+TEST_F(PointReadCoalescingKeyTest, RejectsQueriesOtherThanPointReadsById) {
+    ASSERT_FALSE(makeKey(kKey.addFields(BSON("filter" << BSON("a" << 1)))));
+    ASSERT_FALSE(makeKey(kKey.addFields(BSON("filter" << BSON("_id" << BSON("$gt" << 1))))));
+    ASSERT_FALSE(makeKey(kKey.removeField("filter")));
+}
+
+TEST_F(PointReadCoalescingKeyTest, RejectsTransactions) {
+    opCtx()->setLogicalSessionId(makeLogicalSessionIdForTest());
+    opCtx()->setTxnNumber(0);
+    ASSERT_FALSE(makeKey(kKey));
+
+    opCtx()->setInMultiDocumentTransaction();
+    ASSERT_FALSE(makeKey(kKey));
+}
+
+TEST_F(PointReadCoalescingKeyTest, RejectsLinearizableReadConcern) {
+    repl::ReadConcernArgs::get(opCtx()) =
+        repl::ReadConcernArgs(repl::ReadConcernLevel::kLinearizableReadConcern);
+    ASSERT_FALSE(makeKey(kKey));
+}
+
+TEST_F(PointReadCoalescingKeyTest, RejectsTermTailableAndExhaust) {
+    ASSERT_FALSE(makeKey(kKey.addFields(BSON("term" << 1LL))));
+    ASSERT_FALSE(makeKey(kKey.addFields(BSON("tailable" << true))));
+
+    opCtx()->setExhaust(true);
+    ASSERT_FALSE(makeKey(kKey));
+}
+
+TEST_F(PointReadCoalescingKeyTest, RejectsDirectClient) {
+    opCtx()->getClient()->setInDirectClient(true);
+    ASSERT_FALSE(makeKey(kKey));
+    opCtx()->getClient()->setInDirectClient(false);
+}
+
+TEST_F(PointReadCoalescingKeyTest, IgnoresPerRequestFields) {
+    auto key = makeKey(kKey);
+    ASSERT(key);
+
+    auto withPerRequestFields = makeKey(kKey.addFields(
+        BSON("lsid" << BSON("id" << UUID::gen()) << "comment"
+                    << "request 1"
+                    << "maxTimeMS" << 100 << "clientOperationKey" << UUID::gen() << "$clusterTime"
+                    << BSON("clusterTime" << Timestamp(1, 1)))));
+    ASSERT(withPerRequestFields);
+    ASSERT_BSONOBJ_EQ(*key, *withPerRequestFields);
+}
+
+TEST_F(PointReadCoalescingKeyTest, DistinguishesRequestsThatCanReadDifferentResults) {
+    auto key = makeKey(kKey);
+    ASSERT(key);
+
+    for (auto&& otherFields : {BSON("projection" << BSON("a" << 1)),
+                               BSON("$readPreference" << BSON("mode"
+                                                              << "secondary")),
+                               BSON("collation" << BSON("locale"
+                                                        << "fr"))}) {
+        auto otherKey = makeKey(kKey.addFields(otherFields));
+        ASSERT(otherKey);
+        ASSERT_BSONOBJ_NE(*key, *otherKey);
+    }
+
+    repl::ReadConcernArgs::get(opCtx()) =
+        repl::ReadConcernArgs(repl::ReadConcernLevel::kMajorityReadConcern);
+    auto majorityKey = makeKey(kKey);
+    ASSERT(majorityKey);
+    ASSERT_BSONOBJ_NE(*key, *majorityKey);
+}
+
+}  // namespace
+}  // namespace mongo
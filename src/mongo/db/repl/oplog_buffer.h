@@ -183,6 +183,8 @@ public:
     void clear() {
         count.decrement(count.get());
         size.decrement(size.get());
+        spilledCount.decrement(spilledCount.get());
+        spilledSize.decrement(spilledSize.get());
     }
 
     void increment(const Value& value) {
@@ -195,6 +197,16 @@ public:
         size.decrement(std::size_t(value.objsize()));
     }
 
+    void incrementSpilled(const Value& value) {
+        spilledCount.increment(1);
+        spilledSize.increment(std::size_t(value.objsize()));
+    }
+
+    void decrementSpilled(const Value& value) {
+        spilledCount.decrement(1);
+        spilledSize.decrement(std::size_t(value.objsize()));
+    }
+
     // Number of operations in this OplogBuffer.
     Counter64 count;
 
@@ -203,6 +215,13 @@ public:
 
     // Maximum size of operations in this OplogBuffer. Measured in bytes.
     Counter64 maxSize;
+
+    // Number of operations in this OplogBuffer that are held on disk rather than in memory. Only
+    // maintained by oplog buffers that spill to disk.
+    Counter64 spilledCount;
+
+    // Total size of operations in this OplogBuffer that are held on disk. Measured in bytes.
+    Counter64 spilledSize;
 };
 
 /**
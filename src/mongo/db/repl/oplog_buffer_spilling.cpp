@@ -0,0 +1,303 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_buffer_spilling.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/base/data_view.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/destructor_guard.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace repl {
+
+OplogBufferSpilling::OplogBufferSpilling(Counters* counters, Options options)
+    : _options(std::move(options)), _counters(counters) {
+    invariant(_options.maxSpillSize == 0 || !_options.spillFilePath.empty());
+}
+
+OplogBufferSpilling::~OplogBufferSpilling() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    DESTRUCTOR_GUARD(_removeSpillFile_inlock());
+}
+
+void OplogBufferSpilling::startup(OperationContext*) {
+    // Update server status metric to reflect the current oplog buffer's max size.
+    if (_counters) {
+        _counters->setMaxSize(getMaxSize());
+    }
+}
+
+void OplogBufferSpilling::shutdown(OperationContext* opCtx) {
+    clear(opCtx);
+}
+
+void OplogBufferSpilling::push(OperationContext*,
+                               Batch::const_iterator begin,
+                               Batch::const_iterator end) {
+    if (begin == end) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(!_drainMode);
+    for (auto it = begin; it != end; ++it) {
+        const auto size = std::size_t(it->objsize());
+        // Once anything has been spilled, everything after it must be spilled as well so that
+        // operations are returned in the order in which they were pushed.
+        const bool memoryFull = !_memory.empty() && _memorySize + size > _options.maxMemorySize;
+        if (_options.maxSpillSize > 0 && (_spilledCount > 0 || memoryFull)) {
+            _spill_inlock(*it);
+        } else {
+            _memory.push_back(*it);
+            _memorySize += size;
+        }
+        if (_counters) {
+            _counters->increment(*it);
+        }
+    }
+    _lastPushed = *std::prev(end);
+    _notEmptyCv.notify_one();
+}
+
+void OplogBufferSpilling::waitForSpace(OperationContext*, std::size_t size) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _notFullCv.wait(lk, [&] { return _hasSpaceFor_inlock(size); });
+}
+
+bool OplogBufferSpilling::isEmpty() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _memory.empty() && _spilledCount == 0;
+}
+
+std::size_t OplogBufferSpilling::getMaxSize() const {
+    return _options.maxMemorySize + _options.maxSpillSize;
+}
+
+std::size_t OplogBufferSpilling::getSize() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _memorySize + _spilledSize;
+}
+
+std::size_t OplogBufferSpilling::getCount() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _memory.size() + _spilledCount;
+}
+
+std::size_t OplogBufferSpilling::getSpilledSize() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _spilledSize;
+}
+
+std::size_t OplogBufferSpilling::getSpilledCount() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _spilledCount;
+}
+
+void OplogBufferSpilling::clear(OperationContext*) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _clear_inlock();
+}
+
+bool OplogBufferSpilling::tryPop(OperationContext*, Value* value) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_memory.empty() && _spilledCount > 0) {
+        _unspill_inlock();
+    }
+    if (_memory.empty()) {
+        return false;
+    }
+
+    *value = std::move(_memory.front());
+    _memory.pop_front();
+    _memorySize -= std::size_t(value->objsize());
+    if (_counters) {
+        _counters->decrement(*value);
+    }
+    _notFullCv.notify_one();
+    return true;
+}
+
+bool OplogBufferSpilling::waitForData(Seconds waitDuration) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _notEmptyCv.wait_for(lk, waitDuration.toSystemDuration(), [&] {
+        return _drainMode || !_memory.empty() || _spilledCount > 0;
+    });
+    return !_memory.empty() || _spilledCount > 0;
+}
+
+bool OplogBufferSpilling::peek(OperationContext*, Value* value) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_memory.empty() && _spilledCount > 0) {
+        _unspill_inlock();
+    }
+    if (_memory.empty()) {
+        return false;
+    }
+    *value = _memory.front();
+    return true;
+}
+
+boost::optional<OplogBuffer::Value> OplogBufferSpilling::lastObjectPushed(
+    OperationContext*) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_memory.empty() && _spilledCount == 0) {
+        return boost::none;
+    }
+    return _lastPushed;
+}
+
+void OplogBufferSpilling::enterDrainMode() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _drainMode = true;
+    _notEmptyCv.notify_one();
+}
+
+void OplogBufferSpilling::exitDrainMode() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _drainMode = false;
+}
+
+bool OplogBufferSpilling::_hasSpaceFor_inlock(std::size_t size) const {
+    if (_spilledCount == 0 && (_memory.empty() || _memorySize + size <= _options.maxMemorySize)) {
+        return true;
+    }
+    // Always admit a batch into an empty spill file so that a batch larger than the spill limit
+    // cannot block the producer forever.
+    return _options.maxSpillSize > 0 &&
+        (_spilledCount == 0 || _spilledSize + size <= _options.maxSpillSize);
+}
+
+void OplogBufferSpilling::_spill_inlock(const Value& value) {
+    if (!_spillFile.is_open()) {
+        boost::filesystem::path path(_options.spillFilePath);
+        boost::filesystem::create_directories(path.parent_path());
+        _spillFile.open(path.string(),
+                        std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+        uassert(7100200,
+                str::stream() << "Error opening oplog buffer spill file " << path.string() << ": "
+                              << errnoWithDescription(),
+                _spillFile.good());
+        _spillReadOffset = 0;
+        _spillWriteOffset = 0;
+
+        LOGV2(7100201,
+              "Oplog buffer is full, spilling oplog entries to disk",
+              "path"_attr = path.string(),
+              "memorySizeBytes"_attr = _memorySize);
+    }
+
+    _spillFile.seekp(_spillWriteOffset);
+    _spillFile.write(value.objdata(), value.objsize());
+    uassert(ErrorCodes::OutOfDiskSpace,
+            str::stream() << "Error writing to oplog buffer spill file "
+                          << _options.spillFilePath << ": " << errnoWithDescription(),
+            _spillFile.good());
+
+    _spillWriteOffset += value.objsize();
+    _spilledSize += std::size_t(value.objsize());
+    ++_spilledCount;
+    if (_counters) {
+        _counters->incrementSpilled(value);
+    }
+}
+
+void OplogBufferSpilling::_unspill_inlock() {
+    invariant(_spillFile.is_open());
+
+    _spillFile.flush();
+    _spillFile.seekg(_spillReadOffset);
+    while (_spilledCount > 0 && (_memory.empty() || _memorySize < _options.maxMemorySize)) {
+        char sizeBuf[sizeof(int32_t)];
+        _spillFile.read(sizeBuf, sizeof(sizeBuf));
+        const auto size = ConstDataView(sizeBuf).read<LittleEndian<int32_t>>();
+        uassert(7100202,
+                str::stream() << "Error reading oplog buffer spill file "
+                              << _options.spillFilePath << ": " << errnoWithDescription(),
+                _spillFile.good() && size >= BSONObj::kMinBSONLength &&
+                    _spillReadOffset + size <= _spillWriteOffset);
+
+        auto buf = SharedBuffer::allocate(size);
+        std::memcpy(buf.get(), sizeBuf, sizeof(sizeBuf));
+        _spillFile.read(buf.get() + sizeof(sizeBuf), size - sizeof(sizeBuf));
+        uassert(7100203,
+                str::stream() << "Error reading oplog buffer spill file "
+                              << _options.spillFilePath << ": " << errnoWithDescription(),
+                _spillFile.good());
+
+        BSONObj obj(std::move(buf));
+        _spillReadOffset += size;
+        _spilledSize -= std::size_t(size);
+        --_spilledCount;
+        if (_counters) {
+            _counters->decrementSpilled(obj);
+        }
+
+        _memorySize += std::size_t(size);
+        _memory.push_back(std::move(obj));
+    }
+
+    if (_spilledCount == 0) {
+        _removeSpillFile_inlock();
+    }
+}
+
+void OplogBufferSpilling::_removeSpillFile_inlock() {
+    if (!_spillFile.is_open()) {
+        return;
+    }
+    _spillFile.close();
+    boost::filesystem::remove(_options.spillFilePath);
+    _spillReadOffset = 0;
+    _spillWriteOffset = 0;
+}
+
+void OplogBufferSpilling::_clear_inlock() {
+    _memory.clear();
+    _memorySize = 0;
+    _removeSpillFile_inlock();
+    _spilledSize = 0;
+    _spilledCount = 0;
+    _lastPushed = boost::none;
+    if (_counters) {
+        _counters->clear();
+    }
+    _notFullCv.notify_one();
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <fstream>
+#include <string>
+
+#include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Oplog buffer that keeps operations in memory up to a byte limit and appends any further
+ * operations to a local file once memory is full. Operations are always returned in the order in
+ * which they were pushed: once an operation has been spilled, subsequent pushes are also spilled
+ * until the applier has drained the file back into memory.
+ *
+ * Used for steady state replication so that the oplog fetcher can keep reading from its sync
+ * source while the applier is behind, instead of blocking on a full in-memory buffer.
+ */
+class OplogBufferSpilling final : public OplogBuffer {
+public:
+    struct Options {
+        // Maximum total size of operations held in memory.
+        std::size_t maxMemorySize = 256 * 1024 * 1024;
+
+        // Maximum total size of operations held in the spill file. When the spill file is full,
+        // waitForSpace() blocks until the applier catches up. Spilling is disabled if this is 0.
+        std::size_t maxSpillSize = 0;
+
+        // Path of the spill file. The file is created on the first spill and removed when it has
+        // been fully drained, cleared or when the buffer shuts down.
+        std::string spillFilePath;
+    };
+
+    OplogBufferSpilling(Counters* counters, Options options);
+    ~OplogBufferSpilling();
+
+    void startup(OperationContext* opCtx) override;
+    void shutdown(OperationContext* opCtx) override;
+    void push(OperationContext* opCtx,
+              Batch::const_iterator begin,
+              Batch::const_iterator end) override;
+    void waitForSpace(OperationContext* opCtx, std::size_t size) override;
+    bool isEmpty() const override;
+    std::size_t getMaxSize() const override;
+    std::size_t getSize() const override;
+    std::size_t getCount() const override;
+    void clear(OperationContext* opCtx) override;
+    bool tryPop(OperationContext* opCtx, Value* value) override;
+    bool waitForData(Seconds waitDuration) override;
+    bool peek(OperationContext* opCtx, Value* value) override;
+    boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
+
+    // In drain mode, the buffer does not block. It is the responsibility of the caller to ensure
+    // that no items are added to the buffer while in drain mode; this is enforced by invariant().
+    void enterDrainMode() final;
+    void exitDrainMode() final;
+
+    /**
+     * Returns the total size of the operations currently held in the spill file.
+     */
+    std::size_t getSpilledSize() const;
+
+    /**
+     * Returns the number of operations currently held in the spill file.
+     */
+    std::size_t getSpilledCount() const;
+
+private:
+    bool _hasSpaceFor_inlock(std::size_t size) const;
+
+    /**
+     * Appends 'value' to the end of the spill file, opening the file if necessary.
+     */
+    void _spill_inlock(const Value& value);
+
+    /**
+     * Moves operations from the front of the spill file into memory until memory is full or the
+     * spill file has been drained. Removes the spill file once it has been drained.
+     */
+    void _unspill_inlock();
+
+    void _removeSpillFile_inlock();
+
+    void _clear_inlock();
+
+    const Options _options;
+    Counters* const _counters;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogBufferSpilling::_mutex");
+    stdx::condition_variable _notEmptyCv;
+    stdx::condition_variable _notFullCv;
+    bool _drainMode = false;
+
+    // Operations held in memory, in the order in which they will be returned. If the spill file is
+    // not empty, every operation in memory precedes every operation in the spill file.
+    std::deque<Value> _memory;
+    std::size_t _memorySize = 0;
+
+    std::fstream _spillFile;
+    std::streamoff _spillReadOffset = 0;
+    std::streamoff _spillWriteOffset = 0;
+    std::size_t _spilledSize = 0;
+    std::size_t _spilledCount = 0;
+
+    boost::optional<Value> _lastPushed;
+};
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_spilling.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+BSONObj makeOplogEntry(int t) {
+    return BSON("ts" << Timestamp(t, t) << "ns"
+                     << "a.a"
+                     << "v" << 2 << "op"
+                     << "i"
+                     << "o" << BSON("_id" << t << "a" << t));
+}
+
+class OplogBufferSpillingTest : public unittest::Test {
+protected:
+    OplogBufferSpilling::Options makeOptions(int entriesInMemory, int entriesOnDisk) {
+        const auto entrySize = std::size_t(makeOplogEntry(1).objsize());
+        OplogBufferSpilling::Options options;
+        options.maxMemorySize = entriesInMemory * entrySize;
+        options.maxSpillSize = entriesOnDisk * entrySize;
+        options.spillFilePath = spillFilePath();
+        return options;
+    }
+
+    std::string spillFilePath() const {
+        return _tempDir.path() + "/_tmp/oplogBufferSpill";
+    }
+
+    bool spillFileExists() const {
+        return boost::filesystem::exists(spillFilePath());
+    }
+
+    OplogBuffer::Counters counters;
+
+private:
+    unittest::TempDir _tempDir{"oplog_buffer_spilling_test"};
+};
+
+TEST_F(OplogBufferSpillingTest, PushAndPopWithoutSpilling) {
+    OplogBufferSpilling buffer(&counters, makeOptions(4, 4));
+    buffer.startup(nullptr);
+    ASSERT_EQUALS(buffer.getMaxSize(), std::size_t(counters.maxSize.get()));
+
+    OplogBuffer::Batch batch = {makeOplogEntry(1), makeOplogEntry(2)};
+    buffer.waitForSpace(nullptr, batch[0].objsize() + batch[1].objsize());
+    buffer.push(nullptr, batch.cbegin(), batch.cend());
+    ASSERT_EQUALS(2U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getSpilledCount());
+    ASSERT_FALSE(spillFileExists());
+    ASSERT_BSONOBJ_EQ(batch[1], *buffer.lastObjectPushed(nullptr));
+
+    OplogBuffer::Value value;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+    ASSERT_BSONOBJ_EQ(batch[0], value);
+    ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+    ASSERT_BSONOBJ_EQ(batch[1], value);
+    ASSERT_FALSE(buffer.tryPop(nullptr, &value));
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_FALSE(buffer.lastObjectPushed(nullptr));
+}
+
+TEST_F(OplogBufferSpillingTest, SpillsWhenMemoryIsFullAndPreservesOrder) {
+    OplogBufferSpilling buffer(&counters, makeOptions(2, 8));
+    buffer.startup(nullptr);
+
+    OplogBuffer::Batch batch;
+    std::size_t batchSize = 0;
+    for (int i = 1; i <= 6; ++i) {
+        batch.push_back(makeOplogEntry(i));
+        batchSize += batch.back().objsize();
+    }
+    buffer.waitForSpace(nullptr, batchSize);
+    buffer.push(nullptr, batch.cbegin(), batch.cend());
+
+    ASSERT_EQUALS(6U, buffer.getCount());
+    ASSERT_EQUALS(batchSize, buffer.getSize());
+    ASSERT_EQUALS(4U, buffer.getSpilledCount());
+    ASSERT_EQUALS(4LL, counters.spilledCount.get());
+    ASSERT_EQUALS(std::size_t(counters.spilledSize.get()), buffer.getSpilledSize());
+    ASSERT_TRUE(spillFileExists());
+
+    // Entries pushed while entries are spilled must also be spilled to preserve order, even if
+    // there is room in memory.
+    OplogBuffer::Value value;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+    ASSERT_BSONOBJ_EQ(batch[0], value);
+    OplogBuffer::Batch next = {makeOplogEntry(7)};
+    buffer.push(nullptr, next.cbegin(), next.cend());
+    ASSERT_EQUALS(5U, buffer.getSpilledCount());
+    ASSERT_BSONOBJ_EQ(next[0], *buffer.lastObjectPushed(nullptr));
+
+    batch.push_back(next[0]);
+    for (std::size_t i = 1; i < batch.size(); ++i) {
+        ASSERT_TRUE(buffer.peek(nullptr, &value));
+        ASSERT_BSONOBJ_EQ(batch[i], value);
+        ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+        ASSERT_BSONOBJ_EQ(batch[i], value);
+    }
+
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSpilledCount());
+    ASSERT_EQUALS(0LL, counters.count.get());
+    ASSERT_EQUALS(0LL, counters.spilledCount.get());
+    ASSERT_FALSE(spillFileExists());
+}
+
+TEST_F(OplogBufferSpillingTest, WaitForDataReturnsTrueWhenOnlySpilledEntriesRemain) {
+    OplogBufferSpilling buffer(&counters, makeOptions(1, 4));
+    buffer.startup(nullptr);
+
+    OplogBuffer::Batch batch = {makeOplogEntry(1), makeOplogEntry(2)};
+    buffer.push(nullptr, batch.cbegin(), batch.cend());
+    ASSERT_EQUALS(1U, buffer.getSpilledCount());
+
+    OplogBuffer::Value value;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+    ASSERT_TRUE(buffer.waitForData(Seconds(0)));
+    ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+    ASSERT_BSONOBJ_EQ(batch[1], value);
+    ASSERT_FALSE(buffer.waitForData(Seconds(0)));
+}
+
+TEST_F(OplogBufferSpillingTest, ClearRemovesSpillFile) {
+    OplogBufferSpilling buffer(&counters, makeOptions(1, 4));
+    buffer.startup(nullptr);
+
+    OplogBuffer::Batch batch = {makeOplogEntry(1), makeOplogEntry(2), makeOplogEntry(3)};
+    buffer.push(nullptr, batch.cbegin(), batch.cend());
+    ASSERT_TRUE(spillFileExists());
+
+    buffer.clear(nullptr);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0LL, counters.spilledSize.get());
+    ASSERT_FALSE(spillFileExists());
+
+    // The buffer can spill again after being cleared.
+    buffer.push(nullptr, batch.cbegin(), batch.cend());
+    ASSERT_EQUALS(2U, buffer.getSpilledCount());
+    buffer.shutdown(nullptr);
+    ASSERT_FALSE(spillFileExists());
+}
+
+TEST_F(OplogBufferSpillingTest, DoesNotSpillWhenSpillingIsDisabled) {
+    auto options = makeOptions(1, 0);
+    options.spillFilePath.clear();
+    OplogBufferSpilling buffer(&counters, std::move(options));
+    buffer.startup(nullptr);
+
+    OplogBuffer::Batch batch = {makeOplogEntry(1), makeOplogEntry(2)};
+    buffer.push(nullptr, batch.cbegin(), batch.cend());
+    ASSERT_EQUALS(2U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getSpilledCount());
+}
+
+}  // namespace
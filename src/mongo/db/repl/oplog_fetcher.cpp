@@ -63,6 +63,14 @@ MONGO_FAIL_POINT_DEFINE(hangOplogFetcherBeforeAdvancingLastFetched);
 MONGO_FAIL_POINT_DEFINE(skipWaitingToRecreateCursor);
 
 namespace {
+
+// The smallest batchSize the adaptive batch sizing will request.
+constexpr int kMinAdaptiveBatchSize = 100;
+
+// Time spent waiting for space in the oplog buffer below which the applier is not considered the
+// bottleneck.
+constexpr Milliseconds kMinEnqueueWaitToShrinkBatch{10};
+
 class OplogBatchStats {
 public:
     void recordMillis(int millis, bool isEmptyBatch);
@@ -194,7 +202,8 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
       _dataReplicatorExternalState(dataReplicatorExternalState),
       _enqueueDocumentsFn(enqueueDocumentsFn),
       _awaitDataTimeout(calculateAwaitDataTimeout(config.replSetConfig)),
-      _config(std::move(config)) {
+      _config(std::move(config)),
+      _batchSize(_config.batchSize) {
     invariant(_config.replSetConfig.isInitialized());
     invariant(!_lastFetched.isNull());
     invariant(onShutdownCallbackFn);
@@ -277,6 +286,16 @@ void OplogFetcher::setCreateClientFn_forTest(const CreateClientFn& createClientF
     _createClientFn = createClientFn;
 }
 
+int OplogFetcher::getBatchSize_forTest() const {
+    return _batchSize;
+}
+
+void OplogFetcher::updateBatchSize_forTest(const DocumentsInfo& info,
+                                           Milliseconds fetchTime,
+                                           Milliseconds enqueueWait) {
+    _updateBatchSize(info, fetchTime, enqueueWait);
+}
+
 DBClientConnection* OplogFetcher::getDBClientConnection_forTest() const {
     stdx::lock_guard lock(_mutex);
     return _conn.get();
@@ -351,6 +370,7 @@ void OplogFetcher::_runQuery(const executor::TaskExecutor::CallbackArgs& callbac
         stdx::lock_guard<Latch> lock(_mutex);
         if (!_conn) {
             _conn = _createClientFn();
+            _conn->getCompressorManager().setPreferredCompressor(oplogFetcherPreferredCompressor);
             hadExistingConnection = false;
         }
     }
@@ -648,7 +668,7 @@ Status OplogFetcher::_createNewCursor(bool initialFind) {
             nullptr /* fieldsToReturn */,
             QueryOption_CursorTailable | QueryOption_AwaitData |
                 (oplogFetcherUsesExhaust ? QueryOption_Exhaust : 0),
-            _config.batchSize);
+            _batchSize);
     }
 
     _firstBatch = true;
@@ -697,8 +717,8 @@ StatusWith<OplogFetcher::Documents> OplogFetcher::_getNextBatch() {
             // Due to a bug in DBClientCursor, it actually uses batchSize 2 if the given batchSize
             // is 1 for the find command. So if the given batchSize is 1, we need to set it
             // explicitly for getMores.
-            if (_config.batchSize == 1) {
-                _cursor->setBatchSize(_config.batchSize);
+            if (_batchSize == 1) {
+                _cursor->setBatchSize(_batchSize);
             }
         } else {
             auto lastCommittedWithCurrentTerm =
@@ -707,8 +727,16 @@ StatusWith<OplogFetcher::Documents> OplogFetcher::_getNextBatch() {
                 _cursor->setCurrentTermAndLastCommittedOpTime(lastCommittedWithCurrentTerm.value,
                                                               lastCommittedWithCurrentTerm.opTime);
             }
+            // Exhaust cursors keep streaming with the batchSize of the first getMore, so the
+            // adaptive batch size only takes effect on explicit getMores and recreated cursors.
+            if (!oplogFetcherUsesExhaust && !_config.forTenantMigration) {
+                _cursor->setBatchSize(_batchSize);
+            }
             _cursor->more();
         }
+        // The documents returned by the cursor share ownership of the reply message buffer, so
+        // moving them into the batch does not copy any oplog entries.
+        batch.reserve(_cursor->objsLeftInBatch());
         while (_cursor->moreInCurrentBatch()) {
             batch.emplace_back(_cursor->nextSafe());
         }
@@ -902,10 +930,13 @@ Status OplogFetcher::_onSuccessfulBatch(const Documents& documents) {
     }
 
     try {
+        Timer enqueueTimer;
         auto status = _enqueueDocumentsFn(firstDocToApply, documents.cend(), info);
         if (!status.isOK()) {
             return status;
         }
+        _updateBatchSize(
+            info, Milliseconds(_lastBatchElapsedMS), Milliseconds(enqueueTimer.millis()));
     } catch (const DBException& e) {
         return e.toStatus().withContext("Error inserting documents into oplog buffer collection");
     }
@@ -939,6 +970,40 @@ Status OplogFetcher::_onSuccessfulBatch(const Documents& documents) {
     return Status::OK();
 }
 
+void OplogFetcher::_updateBatchSize(const DocumentsInfo& info,
+                                    Milliseconds fetchTime,
+                                    Milliseconds enqueueWait) {
+    // Tenant migrations use a fixed aggregation batch size and a batchSize of 1 is used by tests
+    // to step through the oplog one entry at a time.
+    if (!oplogFetcherAdaptiveBatchSize.load() || _config.forTenantMigration ||
+        _config.batchSize <= 1) {
+        _batchSize = _config.batchSize;
+        return;
+    }
+
+    if (enqueueWait > kMinEnqueueWaitToShrinkBatch && enqueueWait > fetchTime) {
+        // We spent longer waiting for the applier to free space in the oplog buffer than we did
+        // fetching the batch. Ask for smaller batches so that we do not hold large replies that
+        // cannot be buffered yet.
+        auto fetched = static_cast<int>(std::min<size_t>(info.networkDocumentCount, _batchSize));
+        _batchSize = std::min(_config.batchSize, std::max(kMinAdaptiveBatchSize, fetched / 2));
+    } else if (info.networkDocumentCount >= static_cast<size_t>(_batchSize)) {
+        // The batch was limited by the requested size rather than by the sync source running out
+        // of entries or hitting the reply size limit, and the buffer had room for it.
+        _batchSize = static_cast<int>(
+            std::min<long long>(static_cast<long long>(_batchSize) * 2, _config.batchSize));
+    } else {
+        return;
+    }
+
+    LOGV2_DEBUG(7100101,
+                2,
+                "Oplog fetcher adjusted batch size",
+                "batchSize"_attr = _batchSize,
+                "enqueueWait"_attr = enqueueWait,
+                "fetchTime"_attr = fetchTime);
+}
+
 Status OplogFetcher::_checkRemoteOplogStart(const OplogFetcher::Documents& documents,
                                             OpTime remoteLastOpApplied,
                                             int remoteRBID) {
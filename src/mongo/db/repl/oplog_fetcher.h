@@ -297,6 +297,18 @@ public:
      */
     void setCreateClientFn_forTest(const CreateClientFn& createClientFn);
 
+    /**
+     * Returns the batchSize requested on the next getMore.
+     */
+    int getBatchSize_forTest() const;
+
+    /**
+     * Adjusts the batchSize as if a batch described by 'info' had just been processed.
+     */
+    void updateBatchSize_forTest(const DocumentsInfo& info,
+                                 Milliseconds fetchTime,
+                                 Milliseconds enqueueWait);
+
     /**
      * Get a raw pointer to the client connection. It is the caller's responsibility to not reuse
      * this pointer beyond the lifetime of the underlying client. Used for testing only.
@@ -408,6 +420,16 @@ private:
      */
     Status _onSuccessfulBatch(const Documents& documents);
 
+    /**
+     * Adjusts the batchSize used for subsequent queries after a batch that took 'fetchTime' to
+     * fetch and 'enqueueWait' to enqueue. Shrinks it when enqueueing had to wait for the applier to
+     * free space in the oplog buffer, and grows it back towards the configured batchSize when
+     * batches are filled without such waits.
+     */
+    void _updateBatchSize(const DocumentsInfo& info,
+                          Milliseconds fetchTime,
+                          Milliseconds enqueueWait);
+
     /**
      * Notifies caller that the oplog fetcher has completed processing operations from the remote
      * oplog using the "_onShutdownCallbackFn".
@@ -506,6 +528,10 @@ private:
 
     int _lastBatchElapsedMS = 0;
 
+    // The batchSize to request from the sync source. Starts at the configured batchSize and is
+    // adjusted by _updateBatchSize.
+    int _batchSize;
+
     // Condition to be notified on shutdown.
     stdx::condition_variable _shutdownCondVar;
 };
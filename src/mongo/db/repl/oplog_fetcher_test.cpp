@@ -38,6 +38,7 @@
 #include "mongo/db/vector_clock.h"
 #include "mongo/dbtests/mock/mock_dbclient_connection.h"
 #include "mongo/executor/thread_pool_task_executor_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/rpc/metadata.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
@@ -2552,4 +2553,76 @@ TEST_F(OplogFetcherTest, CheckFindCommandIncludesRequestResumeTokenWhenRequested
     oplogFetcher->join();
 }
 
+TEST_F(OplogFetcherTest, AdaptiveBatchSizeShrinksWhileWaitingForOplogBuffer) {
+    RAIIServerParameterControllerForTest adaptiveBatchSize{"oplogFetcherAdaptiveBatchSize", true};
+    auto oplogFetcher = makeOplogFetcher();
+    ASSERT_EQUALS(defaultBatchSize, oplogFetcher->getBatchSize_forTest());
+
+    // Enqueueing took longer than fetching, so the next batch asks for half of what was fetched.
+    OplogFetcher::DocumentsInfo info;
+    info.networkDocumentCount = 1000;
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(50));
+    ASSERT_EQUALS(500, oplogFetcher->getBatchSize_forTest());
+
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(50));
+    ASSERT_EQUALS(250, oplogFetcher->getBatchSize_forTest());
+
+    // The batch size never drops below the minimum.
+    info.networkDocumentCount = 150;
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(50));
+    ASSERT_EQUALS(100, oplogFetcher->getBatchSize_forTest());
+
+    // Short waits, and waits shorter than the fetch, do not mean the applier is the bottleneck.
+    info.networkDocumentCount = 10;
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(0), Milliseconds(10));
+    ASSERT_EQUALS(100, oplogFetcher->getBatchSize_forTest());
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(100), Milliseconds(50));
+    ASSERT_EQUALS(100, oplogFetcher->getBatchSize_forTest());
+}
+
+TEST_F(OplogFetcherTest, AdaptiveBatchSizeGrowsBackWhenBatchesAreFull) {
+    RAIIServerParameterControllerForTest adaptiveBatchSize{"oplogFetcherAdaptiveBatchSize", true};
+    auto oplogFetcher = makeOplogFetcher();
+
+    OplogFetcher::DocumentsInfo info;
+    info.networkDocumentCount = 1000;
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(50));
+    ASSERT_EQUALS(500, oplogFetcher->getBatchSize_forTest());
+
+    // A full batch that was enqueued without waiting doubles the batch size.
+    info.networkDocumentCount = 500;
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(0));
+    ASSERT_EQUALS(1000, oplogFetcher->getBatchSize_forTest());
+
+    // A batch that was not full leaves it alone.
+    info.networkDocumentCount = 400;
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(0));
+    ASSERT_EQUALS(1000, oplogFetcher->getBatchSize_forTest());
+
+    // It grows back up to, but not beyond, the configured batch size.
+    while (oplogFetcher->getBatchSize_forTest() < defaultBatchSize) {
+        info.networkDocumentCount = oplogFetcher->getBatchSize_forTest();
+        oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(0));
+    }
+    ASSERT_EQUALS(defaultBatchSize, oplogFetcher->getBatchSize_forTest());
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(0));
+    ASSERT_EQUALS(defaultBatchSize, oplogFetcher->getBatchSize_forTest());
+}
+
+TEST_F(OplogFetcherTest, DisablingAdaptiveBatchSizeRestoresConfiguredBatchSize) {
+    auto oplogFetcher = makeOplogFetcher();
+    OplogFetcher::DocumentsInfo info;
+    info.networkDocumentCount = 1000;
+
+    {
+        RAIIServerParameterControllerForTest adaptiveBatchSize{"oplogFetcherAdaptiveBatchSize",
+                                                               true};
+        oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(50));
+        ASSERT_EQUALS(500, oplogFetcher->getBatchSize_forTest());
+    }
+
+    oplogFetcher->updateBatchSize_forTest(info, Milliseconds(5), Milliseconds(50));
+    ASSERT_EQUALS(defaultBatchSize, oplogFetcher->getBatchSize_forTest());
+}
+
 }  // namespace
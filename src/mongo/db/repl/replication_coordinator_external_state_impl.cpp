@@ -33,6 +33,7 @@
 
 #include "mongo/db/repl/replication_coordinator_external_state_impl.h"
 
+#include <boost/filesystem/path.hpp>
 #include <functional>
 #include <memory>
 #include <string>
@@ -70,6 +71,7 @@
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier_impl.h"
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_buffer_spilling.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -93,6 +95,7 @@
 #include "mongo/db/storage/control/journal_flusher.h"
 #include "mongo/db/storage/flow_control.h"
 #include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/db/system_index.h"
 #include "mongo/db/vector_clock.h"
 #include "mongo/db/vector_clock_metadata_hook.h"
@@ -142,6 +145,29 @@ ServerStatusMetricField<Counter64> displayBufferSize("repl.buffer.sizeBytes", &b
 // set to 0.
 ServerStatusMetricField<Counter64> displayBufferMaxSize("repl.buffer.maxSizeBytes",
                                                         &bufferGauge.maxSize);
+// The count and size (bytes) of items in the buffer that have been spilled to disk.
+ServerStatusMetricField<Counter64> displayBufferSpilledCount("repl.buffer.spilledCount",
+                                                             &bufferGauge.spilledCount);
+ServerStatusMetricField<Counter64> displayBufferSpilledSize("repl.buffer.spilledSizeBytes",
+                                                            &bufferGauge.spilledSize);
+
+// Limit the in-memory part of the spilling oplog buffer to the size of the blocking queue.
+const std::size_t kSpillingOplogBufferMaxMemorySize = 256 * 1024 * 1024;
+const char kOplogBufferSpillFileName[] = "oplogBufferSpill";
+
+std::unique_ptr<OplogBuffer> makeSteadyStateOplogBuffer() {
+    if (oplogBufferMaxSpillSizeBytes > 0) {
+        OplogBufferSpilling::Options options;
+        options.maxMemorySize = kSpillingOplogBufferMaxMemorySize;
+        options.maxSpillSize = static_cast<std::size_t>(oplogBufferMaxSpillSizeBytes);
+        options.spillFilePath =
+            (boost::filesystem::path(storageGlobalParams.dbpath) / "_tmp" /
+             kOplogBufferSpillFileName)
+                .string();
+        return std::make_unique<OplogBufferSpilling>(&bufferGauge, std::move(options));
+    }
+    return std::make_unique<OplogBufferBlockingQueue>(&bufferGauge);
+}
 
 /**
  * Returns new thread pool for thread pool task executor.
@@ -219,10 +245,10 @@ void ReplicationCoordinatorExternalStateImpl::startSteadyStateReplication(
         return;
 
     invariant(replCoord);
-    _oplogBuffer = std::make_unique<OplogBufferBlockingQueue>(&bufferGauge);
+    _oplogBuffer = makeSteadyStateOplogBuffer();
 
-    // No need to log OplogBuffer::startup because the blocking queue implementation
-    // does not start any threads or access the storage layer.
+    // No need to log OplogBuffer::startup because neither the blocking queue nor the spilling
+    // implementation starts any threads or accesses the storage layer.
     _oplogBuffer->startup(opCtx);
 
     invariant(!_oplogApplier);
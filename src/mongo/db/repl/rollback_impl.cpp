@@ -53,6 +53,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/apply_ops.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
+#include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/roll_back_local_operations.h"
@@ -1219,6 +1220,13 @@ boost::optional<BSONObj> RollbackImpl::_findDocumentById(OperationContext* opCtx
 Status RollbackImpl::_writeRollbackFiles(OperationContext* opCtx) {
     auto catalog = CollectionCatalog::get(opCtx);
     auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+
+    struct RollbackFileToWrite {
+        UUID uuid;
+        NamespaceString nss;
+        const SimpleBSONObjUnorderedSet* idSet;
+    };
+    std::vector<RollbackFileToWrite> filesToWrite;
     for (auto&& entry : _observerInfo.rollbackDeletedIdsMap) {
         const auto& uuid = entry.first;
         const auto nss = catalog->lookupNSSByUUID(opCtx, uuid);
@@ -1240,9 +1248,54 @@ Status RollbackImpl::_writeRollbackFiles(OperationContext* opCtx) {
                   str::stream() << "The collection with UUID " << uuid
                                 << " is unexpectedly missing in the CollectionCatalog");
 
-        _writeRollbackFileForNamespace(opCtx, uuid, *nss, entry.second);
+        filesToWrite.push_back({uuid, *nss, &entry.second});
+    }
+
+    const auto threadCount = std::min(
+        static_cast<std::size_t>(gRollbackFileWriterThreadCount.load()), filesToWrite.size());
+    if (threadCount <= 1) {
+        for (auto&& file : filesToWrite) {
+            _writeRollbackFileForNamespace(opCtx, file.uuid, file.nss, *file.idSet);
+        }
+        return Status::OK();
+    }
+
+    // Each rollback file only reads documents from its own collection, so files for different
+    // collections can be written concurrently. Nothing else writes to the data files until we
+    // recover to the stable timestamp.
+    LOGV2(7100300,
+          "Writing rollback files concurrently",
+          "numCollections"_attr = filesToWrite.size(),
+          "numThreads"_attr = threadCount);
+    auto writerPool = makeReplWriterPool(static_cast<int>(threadCount), "RollbackFileWriter"_sd);
+    std::vector<Status> statuses(filesToWrite.size(), Status::OK());
+    for (std::size_t i = 0; i < filesToWrite.size(); ++i) {
+        auto& file = filesToWrite[i];
+        auto& status = statuses[i];
+        writerPool->schedule([this, &file, &status](auto scheduled) {
+            if (!scheduled.isOK()) {
+                status = scheduled;
+                return;
+            }
+            try {
+                auto writerOpCtx = cc().makeOperationContext();
+                ShouldNotConflictWithSecondaryBatchApplicationBlock noConflict(
+                    writerOpCtx->lockState());
+                _writeRollbackFileForNamespace(writerOpCtx.get(), file.uuid, file.nss, *file.idSet);
+            } catch (const DBException& e) {
+                status = e.toStatus();
+            }
+        });
     }
+    writerPool->waitForIdle();
+    writerPool->shutdown();
+    writerPool->join();
 
+    for (auto&& status : statuses) {
+        if (!status.isOK()) {
+            return status;
+        }
+    }
     return Status::OK();
 }
 
@@ -1271,6 +1324,7 @@ void RollbackImpl::_writeRollbackFileForNamespace(OperationContext* opCtx,
     // If this is the first data directory created, we save the full directory path in
     // _rollbackStats. Otherwise, we store the longest common prefix of the two directories.
     const auto& newDirectoryPath = removeSaver.root().generic_string();
+    stdx::unique_lock<Latch> lk(_rollbackFilesMutex);
     if (!_rollbackStats.rollbackDataFileDirectory) {
         _rollbackStats.rollbackDataFileDirectory = newDirectoryPath;
     } else {
@@ -1282,6 +1336,7 @@ void RollbackImpl::_writeRollbackFileForNamespace(OperationContext* opCtx,
                                     .first;
         _rollbackStats.rollbackDataFileDirectory = std::string(newDirectoryPath.begin(), prefixEnd);
     }
+    lk.unlock();
 
     for (auto&& id : idSet) {
         // StorageInterface::findById() does not respect the collation, but because we are using
@@ -1292,6 +1347,8 @@ void RollbackImpl::_writeRollbackFileForNamespace(OperationContext* opCtx,
             fassert(50750, removeSaver.goingToDelete(*document));
         }
     }
+
+    lk.lock();
     _listener->onRollbackFileWrittenForNamespace(std::move(uuid), std::move(nss));
 }
 
@@ -305,7 +305,9 @@ protected:
      * Writes a rollback file for the namespace 'nss' containing all of the documents whose _ids are
      * listed in 'idSet'.
      *
-     * This function is protected so that subclasses can override it for test purposes.
+     * This function is protected so that subclasses can override it for test purposes. It may be
+     * called concurrently for different namespaces, so overrides must hold '_rollbackFilesMutex'
+     * while touching shared state.
      */
     virtual void _writeRollbackFileForNamespace(OperationContext* opCtx,
                                                 UUID uuid,
@@ -323,6 +325,9 @@ protected:
     // A listener that's called at various points throughout rollback.
     Listener* _listener;  // (R)
 
+    // Serializes the shared state updated while rollback files are written concurrently.
+    Mutex _rollbackFilesMutex = MONGO_MAKE_LATCH("RollbackImpl::_rollbackFilesMutex");  // (S)
+
 private:
     /**
      * Returns if shutdown was called on this rollback process.
@@ -123,9 +123,11 @@ protected:
                       id.jsonString(JsonStringFormat::LegacyStrict));
             auto document = _findDocumentById(opCtx, uuid, nss, id.firstElement());
             if (document) {
+                stdx::lock_guard<Latch> lk(_rollbackFilesMutex);
                 _uuidToObjsMap[uuid].push_back(*document);
             }
         }
+        stdx::lock_guard<Latch> lk(_rollbackFilesMutex);
         _listener->onRollbackFileWrittenForNamespace(std::move(uuid), std::move(nss));
     }
 
@@ -377,6 +377,21 @@ void MigrationDestinationManager::report(BSONObjBuilder& b,
     bb.append("catchup", _numCatchup);
     bb.append("steady", _numSteady);
     bb.done();
+
+    if (_cloneStartDate) {
+        _appendCloneThroughput(sl, b);
+    }
+}
+
+void MigrationDestinationManager::_appendCloneThroughput(WithLock, BSONObjBuilder& b) const {
+    invariant(_cloneStartDate);
+    const auto elapsed = _cloneEndDate.value_or(Date_t::now()) - *_cloneStartDate;
+    const double elapsedSecs = std::max(durationCount<Milliseconds>(elapsed), 1LL) / 1000.0;
+
+    BSONObjBuilder bb(b.subobjStart("cloneThroughput"));
+    bb.append("elapsedMillis", durationCount<Milliseconds>(elapsed));
+    bb.append("docsPerSecond", static_cast<long long>(_numCloned / elapsedSecs));
+    bb.append("bytesPerSecond", static_cast<long long>(_clonedBytes / elapsedSecs));
 }
 
 BSONObj MigrationDestinationManager::getMigrationStatusReport() {
@@ -425,6 +440,8 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 
     _numCloned = 0;
     _clonedBytes = 0;
+    _cloneStartDate = boost::none;
+    _cloneEndDate = boost::none;
     _numCatchup = 0;
     _numSteady = 0;
 
@@ -450,15 +467,19 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::fetchAndApplyBatch(
     OperationContext* opCtx,
     std::function<bool(OperationContext*, BSONObj)> applyBatchFn,
-    std::function<bool(OperationContext*, BSONObj*)> fetchBatchFn) {
+    std::function<bool(OperationContext*, BSONObj*)> fetchBatchFn,
+    int numApplierThreads) {
+    invariant(numApplierThreads > 0);
+
+    SingleProducerMultiConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = numApplierThreads;
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    SingleProducerMultiConsumerQueue<BSONObj> batches(options);
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    Mutex lastOpAppliedMutex = MONGO_MAKE_LATCH("MigrationDestinationManager::lastOpAppliedMutex");
     repl::OpTime lastOpApplied;
 
-    stdx::thread applicationThread{[&] {
+    auto applyBatches = [&] {
         Client::initThread("batchApplier", opCtx->getServiceContext(), nullptr);
         auto client = Client::getCurrent();
         {
@@ -472,8 +493,10 @@ repl::OpTime MigrationDestinationManager::fetchAndApplyBatch(
 
         auto consumerGuard = makeGuard([&] {
             batches.closeConsumerEnd();
-            lastOpApplied =
+            auto threadLastOp =
                 repl::ReplClientInfo::forClient(applicationOpCtx->getClient()).getLastOp();
+            stdx::lock_guard<Latch> lk(lastOpAppliedMutex);
+            lastOpApplied = std::max(lastOpApplied, threadLastOp);
         });
 
         try {
@@ -483,6 +506,10 @@ repl::OpTime MigrationDestinationManager::fetchAndApplyBatch(
                     return;
                 }
             }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // Another applier thread consumed the final, empty batch and closed the queue, or the
+            // producer stopped after failing to fetch a batch, in which case it reports the error.
+            return;
         } catch (...) {
             stdx::lock_guard<Client> lk(*opCtx->getClient());
             opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
@@ -491,13 +518,20 @@ repl::OpTime MigrationDestinationManager::fetchAndApplyBatch(
                   "Batch application failed",
                   "error"_attr = redact(exceptionToStatus()));
         }
-    }};
+    };
 
+    std::vector<stdx::thread> applicationThreads;
+    applicationThreads.reserve(numApplierThreads);
+    for (int i = 0; i < numApplierThreads; ++i) {
+        applicationThreads.emplace_back(applyBatches);
+    }
 
     {
         auto applicationThreadJoinGuard = makeGuard([&] {
             batches.closeProducerEnd();
-            applicationThread.join();
+            for (auto& applicationThread : applicationThreads) {
+                applicationThread.join();
+            }
         });
 
         while (true) {
@@ -1186,7 +1220,26 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = fetchAndApplyBatch(opCtx, insertBatchFn, fetchBatchFn);
+        {
+            stdx::lock_guard<Latch> sl(_mutex);
+            _cloneStartDate = Date_t::now();
+        }
+
+        // Waiting for the secondaryThrottle checks the session of 'outerOpCtx' back in, which can
+        // only be done by one insertion thread at a time, so only insert concurrently without it.
+        const int numInsertionThreads =
+            _writeConcern.needToWaitForOtherNodes() ? 1 : migrateCloneInsertionThreads.load();
+        lastOpApplied =
+            fetchAndApplyBatch(opCtx, insertBatchFn, fetchBatchFn, numInsertionThreads);
+
+        {
+            stdx::lock_guard<Latch> sl(_mutex);
+            _cloneEndDate = Date_t::now();
+
+            BSONObjBuilder throughput;
+            _appendCloneThroughput(sl, throughput);
+            timing.appendDetails(throughput.obj());
+        }
 
         timing.done(4);
         migrateThreadHangAtStep4.pauseWhileSet();
@@ -113,12 +113,16 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. Batches returned by 'fetchBatchFn' are handed to
+     * 'numApplierThreads' threads running 'applyBatchFn'. With more than one applier thread the
+     * batches may be applied out of order, so it must only be used when the order of application
+     * does not matter.
      */
     static repl::OpTime fetchAndApplyBatch(
         OperationContext* opCtx,
         std::function<bool(OperationContext*, BSONObj)> applyBatchFn,
-        std::function<bool(OperationContext*, BSONObj*)> fetchBatchFn);
+        std::function<bool(OperationContext*, BSONObj*)> fetchBatchFn,
+        int numApplierThreads = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -222,6 +226,12 @@ private:
      */
     bool _isActive(WithLock) const;
 
+    /**
+     * Appends a 'cloneThroughput' subobject reporting the duration of the cloning step and the
+     * rate at which documents were cloned. Must only be called once cloning has started.
+     */
+    void _appendCloneThroughput(WithLock, BSONObjBuilder& b) const;
+
     // Mutex to guard all fields
     mutable Mutex _mutex = MONGO_MAKE_LATCH("MigrationDestinationManager::_mutex");
 
@@ -258,6 +268,12 @@ private:
 
     long long _numCloned{0};
     long long _clonedBytes{0};
+
+    // Wall clock times at which the cloning step started and finished, used to report the clone
+    // throughput of the migration.
+    boost::optional<Date_t> _cloneStartDate;
+    boost::optional<Date_t> _cloneEndDate;
+
     long long _numCatchup{0};
     long long _numSteady{0};
 
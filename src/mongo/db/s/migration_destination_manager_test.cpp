@@ -110,6 +110,49 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that every fetched batch is applied exactly once when several applier threads are used.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsWithMultipleApplierThreads) {
+    const int kNumBatches = 20;
+    int numFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx, BSONObj* nextBatch) {
+        BSONArrayBuilder arrayBuilder;
+        if (numFetched < kNumBatches) {
+            arrayBuilder.append(createDocument(numFetched));
+        }
+        ++numFetched;
+
+        *nextBatch = BSON("objects" << arrayBuilder.arr());
+        return nextBatch->getField("objects").Obj().isEmpty();
+    };
+
+    auto resultDocsMutex = MONGO_MAKE_LATCH();
+    std::vector<BSONObj> resultDocs;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        auto arr = docs["objects"].Obj();
+        if (arr.isEmpty())
+            return false;
+        stdx::lock_guard<Latch> lk(resultDocsMutex);
+        for (auto&& docToClone : arr) {
+            resultDocs.push_back(docToClone.Obj().getOwned());
+        }
+        return true;
+    };
+
+    MigrationDestinationManager::fetchAndApplyBatch(
+        operationContext(), insertBatchFn, fetchBatchFn, 4 /* numApplierThreads */);
+
+    ASSERT_EQ(static_cast<size_t>(kNumBatches), resultDocs.size());
+
+    std::sort(resultDocs.begin(), resultDocs.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs["_id"].numberInt() < rhs["_id"].numberInt();
+    });
+    for (int i = 0; i < kNumBatches; ++i) {
+        ASSERT_BSONOBJ_EQ(createDocument(i), resultDocs[i]);
+    }
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
@@ -55,6 +55,11 @@ public:
 
     void done(int step);
 
+    /**
+     * Adds the fields of 'details' to the document logged to the changelog for this move.
+     */
+    void appendDetails(const BSONObj& details);
+
 private:
     // Measures how long the receiving of a chunk takes
     Timer _t;
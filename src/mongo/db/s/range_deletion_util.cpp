@@ -113,19 +113,126 @@ bool collectionUuidHasChanged(const NamespaceString& nss,
     return false;
 }
 
+/**
+ * Logs the execution stats of 'exec', which failed with 'ex' while deleting [min, max) in 'nss'.
+ */
+void logCursorError(PlanExecutor* exec,
+                    const BSONObj& min,
+                    const BSONObj& max,
+                    const NamespaceString& nss,
+                    const DBException& ex) {
+    auto&& explainer = exec->getPlanExplainer();
+    auto&& [stats, _] = explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
+    LOGV2_WARNING(23776,
+                  "Cursor error while trying to delete {min} to {max} in {namespace}, "
+                  "stats: {stats}, error: {error}",
+                  "Cursor error while trying to delete range",
+                  "min"_attr = redact(min),
+                  "max"_attr = redact(max),
+                  "namespace"_attr = nss,
+                  "stats"_attr = redact(stats),
+                  "error"_attr = redact(ex.toStatus()));
+}
+
+/**
+ * Deletes the documents of up to 'numDocsToRemovePerBatch' entries of 'descriptor' within
+ * [min, max). Rather than deleting each document in its own storage transaction as it is found by
+ * the index scan, collects the RecordIds of the whole batch first and then deletes the documents in
+ * RecordId order in a single WriteUnitOfWork, so that the records and the keys of each index are
+ * removed in storage order and the batch is committed at once. Must be called under the collection
+ * lock.
+ *
+ * Returns the number of documents deleted, 0 if done with the range.
+ */
+int deleteNextBatchInRecordIdOrder(OperationContext* opCtx,
+                                   const CollectionPtr& collection,
+                                   const IndexDescriptor* descriptor,
+                                   const BSONObj& min,
+                                   const BSONObj& max,
+                                   int numDocsToRemovePerBatch,
+                                   long long* bytesDeleted) {
+    if (throwWriteConflictExceptionInDeleteRange.shouldFail()) {
+        throw WriteConflictException();
+    }
+
+    if (throwInternalErrorInDeleteRange.shouldFail()) {
+        uasserted(ErrorCodes::InternalError, "Failing for test");
+    }
+
+    return writeConflictRetry(opCtx, "rangeDeletion", collection->ns().ns(), [&] {
+        *bytesDeleted = 0;
+        WriteUnitOfWork wuow(opCtx);
+
+        std::vector<std::pair<RecordId, BSONObj>> toDelete;
+        {
+            auto exec = InternalPlanner::indexScan(opCtx,
+                                                   &collection,
+                                                   descriptor,
+                                                   min,
+                                                   max,
+                                                   BoundInclusion::kIncludeStartKeyOnly,
+                                                   PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                                   InternalPlanner::FORWARD,
+                                                   InternalPlanner::IXSCAN_FETCH);
+
+            BSONObj doc;
+            RecordId rid;
+            try {
+                while (static_cast<int>(toDelete.size()) < numDocsToRemovePerBatch &&
+                       exec->getNext(&doc, &rid) == PlanExecutor::ADVANCED) {
+                    toDelete.emplace_back(rid, doc.getOwned());
+                }
+            } catch (const DBException& ex) {
+                logCursorError(exec.get(), min, max, collection->ns(), ex);
+                throw;
+            }
+        }
+
+        // The shard key index may be multikey on fields following the shard key, in which case the
+        // same document can be found more than once.
+        std::sort(toDelete.begin(), toDelete.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        toDelete.erase(std::unique(toDelete.begin(),
+                                   toDelete.end(),
+                                   [](const auto& lhs, const auto& rhs) {
+                                       return lhs.first == rhs.first;
+                                   }),
+                       toDelete.end());
+
+        const auto snapshotId = opCtx->recoveryUnit()->getSnapshotId();
+        for (auto&& [rid, doc] : toDelete) {
+            collection->deleteDocument(opCtx,
+                                       Snapshotted<BSONObj>(snapshotId, doc),
+                                       kUninitializedStmtId,
+                                       rid,
+                                       nullptr /* opDebug */,
+                                       true /* fromMigrate */);
+            *bytesDeleted += doc.objsize();
+        }
+
+        wuow.commit();
+
+        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(toDelete.size());
+        return static_cast<int>(toDelete.size());
+    });
+}
+
 /**
  * Performs the deletion of up to numDocsToRemovePerBatch entries within the range in progress. Must
  * be called under the collection lock.
  *
  * Returns the number of documents deleted, 0 if done with the range, or bad status if deleting
- * the range failed.
+ * the range failed. The total size of the deleted documents is returned in 'bytesDeleted'.
  */
 StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                                 const CollectionPtr& collection,
                                 BSONObj const& keyPattern,
                                 ChunkRange const& range,
-                                int numDocsToRemovePerBatch) {
+                                int numDocsToRemovePerBatch,
+                                long long* bytesDeleted) {
     invariant(collection);
+    *bytesDeleted = 0;
 
     auto const nss = collection->ns();
 
@@ -172,6 +279,16 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                             "namespace"_attr = nss.ns());
     }
 
+    if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
+        LOGV2(23768, "Hit hangBeforeDoingDeletion failpoint");
+        hangBeforeDoingDeletion.pauseWhileSet(opCtx);
+    }
+
+    if (rangeDeleterDeleteInRecordIdOrder.load() && !serverGlobalParams.moveParanoia) {
+        return deleteNextBatchInRecordIdOrder(
+            opCtx, collection, descriptor, min, max, numDocsToRemovePerBatch, bytesDeleted);
+    }
+
     auto deleteStageParams = std::make_unique<DeleteStageParams>();
     deleteStageParams->fromMigrate = true;
     deleteStageParams->isMulti = true;
@@ -192,11 +309,6 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                                                      PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
                                                      InternalPlanner::FORWARD);
 
-    if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
-        LOGV2(23768, "Hit hangBeforeDoingDeletion failpoint");
-        hangBeforeDoingDeletion.pauseWhileSet(opCtx);
-    }
-
     int numDeleted = 0;
     do {
         BSONObj deletedObj;
@@ -213,18 +325,7 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
         try {
             state = exec->getNext(&deletedObj, nullptr);
         } catch (const DBException& ex) {
-            auto&& explainer = exec->getPlanExplainer();
-            auto&& [stats, _] =
-                explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
-            LOGV2_WARNING(23776,
-                          "Cursor error while trying to delete {min} to {max} in {namespace}, "
-                          "stats: {stats}, error: {error}",
-                          "Cursor error while trying to delete range",
-                          "min"_attr = redact(min),
-                          "max"_attr = redact(max),
-                          "namespace"_attr = nss,
-                          "stats"_attr = redact(stats),
-                          "error"_attr = redact(ex.toStatus()));
+            logCursorError(exec.get(), min, max, nss, ex);
             throw;
         }
 
@@ -234,6 +335,7 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
 
         invariant(PlanExecutor::ADVANCED == state);
         ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
+        *bytesDeleted += deletedObj.objsize();
 
     } while (++numDeleted < numDocsToRemovePerBatch);
 
@@ -296,6 +398,8 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const boost::optional<UUID>& migrationId,
                                           int numDocsToRemovePerBatch,
                                           Milliseconds delayBetweenBatches) {
+    const RangeDeletionThrottle throttle(delayBetweenBatches);
+
     return AsyncTry([=] {
                return withTemporaryOperationContext([=](OperationContext* opCtx) {
                    LOGV2_DEBUG(5346200,
@@ -320,11 +424,14 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                        "deletion task. No need to delete documents.",
                        !collectionUuidHasChanged(nss, collection.getCollection(), collectionUuid));
 
+                   long long bytesDeleted = 0;
                    auto numDeleted = uassertStatusOK(deleteNextBatch(opCtx,
                                                                      collection.getCollection(),
                                                                      keyPattern,
                                                                      range,
-                                                                     numDocsToRemovePerBatch));
+                                                                     numDocsToRemovePerBatch,
+                                                                     &bytesDeleted));
+                   throttle.noteBatchDeleted(bytesDeleted);
 
                    LOGV2_DEBUG(
                        23769,
@@ -352,7 +459,7 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                 ErrorCodes::isShutdownError(swNumDeleted.getStatus()) ||
                 ErrorCodes::isNotPrimaryError(swNumDeleted.getStatus());
         })
-        .withDelayBetweenIterations(delayBetweenBatches)
+        .withBackoffBetweenIterations(throttle)
         .on(executor, CancellationToken::uncancelable())
         .ignoreValue();
 }
@@ -425,6 +532,24 @@ std::vector<RangeDeletionTask> getPersistentRangeDeletionTasks(OperationContext*
 
 }  // namespace
 
+RangeDeletionThrottle::RangeDeletionThrottle(Milliseconds delayBetweenBatches)
+    : _delayBetweenBatches(delayBetweenBatches),
+      _lastBatchBytes(std::make_shared<AtomicWord<long long>>(0)) {}
+
+void RangeDeletionThrottle::noteBatchDeleted(long long bytesDeleted) const {
+    _lastBatchBytes->store(bytesDeleted);
+}
+
+Milliseconds RangeDeletionThrottle::nextSleep() const {
+    const long long maxBytesPerSecond = rangeDeleterMaxBytesPerSecond.load();
+    if (maxBytesPerSecond <= 0) {
+        return _delayBetweenBatches;
+    }
+
+    const Milliseconds ioBudgetDelay(_lastBatchBytes->load() * 1000 / maxBytesPerSecond);
+    return std::max(_delayBetweenBatches, ioBudgetDelay);
+}
+
 void snapshotRangeDeletionsForRename(OperationContext* opCtx,
                                      const NamespaceString& fromNss,
                                      const NamespaceString& toNss) {
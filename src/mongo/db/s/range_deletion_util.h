@@ -29,13 +29,16 @@
 #pragma once
 
 #include <list>
+#include <memory>
 
 #include <boost/optional.hpp>
 
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
 #include "mongo/executor/task_executor.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/s/catalog/type_chunk.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -51,6 +54,42 @@ extern AtomicWord<int> rangeDeleterBatchSize;
 // next batch of deletions.
 extern AtomicWord<int> rangeDeleterBatchDelayMS;
 
+// Whether each batch of document deletions collects the RecordIds of the batch first and then
+// deletes the documents in RecordId order within a single storage transaction.
+extern AtomicWord<bool> rangeDeleterDeleteInRecordIdOrder;
+
+// If positive, the time between two batches of document deletions is extended so that the range
+// deleter removes no more than this many bytes of documents per second on average.
+extern AtomicWord<long long> rangeDeleterMaxBytesPerSecond;
+
+/**
+ * Backoff policy for the delay between two range deletion batches. The delay is at least
+ * 'delayBetweenBatches'. If rangeDeleterMaxBytesPerSecond is set, the delay is lengthened in
+ * proportion to the size of the documents deleted by the previous batch, so that on average the
+ * range deleter does not remove more than that many bytes of documents per second.
+ *
+ * Copies share the size of the last batch, so that a copy captured by the code deleting the
+ * batches and a copy captured by the code sleeping between them agree.
+ */
+class RangeDeletionThrottle {
+public:
+    explicit RangeDeletionThrottle(Milliseconds delayBetweenBatches);
+
+    /**
+     * Records the total size of the documents deleted by the last batch.
+     */
+    void noteBatchDeleted(long long bytesDeleted) const;
+
+    /**
+     * Returns how long to wait before deleting the next batch.
+     */
+    Milliseconds nextSleep() const;
+
+private:
+    Milliseconds _delayBetweenBatches;
+    std::shared_ptr<AtomicWord<long long>> _lastBatchBytes;
+};
+
 /**
  * Deletes a range of orphaned documents for the given namespace and collection UUID. Returns a
  * future which will be resolved when the range has finished being deleted. The resulting future
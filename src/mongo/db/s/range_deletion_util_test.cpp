@@ -32,6 +32,8 @@
 #include "mongo/db/catalog/create_collection.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
+#include "mongo/db/op_observer_noop.h"
+#include "mongo/db/op_observer_registry.h"
 #include "mongo/db/persistent_task_store.h"
 #include "mongo/db/repl/wait_for_majority_service.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
@@ -43,8 +45,11 @@
 #include "mongo/db/s/shard_server_test_fixture.h"
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/vector_clock.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -53,6 +58,30 @@ const NamespaceString kNss = NamespaceString("foo", "bar");
 const std::string kShardKey = "_id";
 const BSONObj kShardKeyPattern = BSON(kShardKey << 1);
 
+/**
+ * Records the shard key of each document deleted from 'kNss', in deletion order.
+ */
+class DeletedShardKeysObserver : public OpObserverNoop {
+public:
+    void aboutToDelete(OperationContext* opCtx,
+                       const NamespaceString& nss,
+                       const BSONObj& doc) override {
+        if (nss == kNss) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _deleted.push_back(doc[kShardKey].numberInt());
+        }
+    }
+
+    std::vector<int> getDeleted() const {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _deleted;
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("DeletedShardKeysObserver::_mutex");
+    std::vector<int> _deleted;
+};
+
 class RangeDeleterTest : public ShardServerTestFixture {
 public:
     // Needed because UUID default constructor is private
@@ -254,6 +283,52 @@ TEST_F(RangeDeleterTest,
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeDeletesInRecordIdOrderWhenEnabled) {
+    rangeDeleterDeleteInRecordIdOrder.store(true);
+    ON_BLOCK_EXIT([] { rangeDeleterDeleteInRecordIdOrder.store(false); });
+
+    auto observer = std::make_unique<DeletedShardKeysObserver>();
+    auto deletedShardKeys = observer.get();
+    checked_cast<OpObserverRegistry*>(getServiceContext()->getOpObserver())
+        ->addObserver(std::move(observer));
+
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    const auto numDocsToRemovePerBatch = 2;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    // Insert the documents in the opposite order of their shard key, so that the RecordId order of
+    // the documents differs from the order in which the shard key index returns them.
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 9; i >= 0; --i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+    dbclient.insert(kNss.toString(), BSON(kShardKey << 10));
+    dbclient.insert(kNss.toString(), BSON(kShardKey << -1));
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete*/,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 2);
+    ASSERT_EQUALS(dbclient.count(kNss, BSON(kShardKey << 10)), 1);
+    ASSERT_EQUALS(dbclient.count(kNss, BSON(kShardKey << -1)), 1);
+
+    // Each batch is found in shard key order, but deleted in the order the documents were
+    // inserted, which is the reverse.
+    const std::vector<int> expected{1, 0, 3, 2, 5, 4, 7, 6, 9, 8};
+    ASSERT_TRUE(deletedShardKeys->getDeleted() == expected);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeInsertsDocumentToNotifySecondariesOfRangeDeletion) {
     const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
     const int numDocsToRemovePerBatch = 10;
@@ -1040,5 +1115,34 @@ TEST_F(RenameRangeDeletionsTest, IdempotentRenameRangeDeletionsTest) {
     ASSERT_EQ(0, forRenameStore.count(operationContext(), BSONObj()));
 }
 
+TEST(RangeDeletionThrottleTest, WaitsDelayBetweenBatchesWithoutByteRate) {
+    RangeDeletionThrottle throttle(Milliseconds(50));
+    ASSERT_EQ(Milliseconds(50), throttle.nextSleep());
+
+    throttle.noteBatchDeleted(16 * 1024 * 1024);
+    ASSERT_EQ(Milliseconds(50), throttle.nextSleep());
+}
+
+TEST(RangeDeletionThrottleTest, WaitsLongEnoughToStayWithinByteRate) {
+    RAIIServerParameterControllerForTest maxBytesPerSecond{"rangeDeleterMaxBytesPerSecond", 1000};
+    RangeDeletionThrottle throttle(Milliseconds(50));
+
+    throttle.noteBatchDeleted(500);
+    ASSERT_EQ(Milliseconds(500), throttle.nextSleep());
+
+    // The delay between batches is still the minimum.
+    throttle.noteBatchDeleted(10);
+    ASSERT_EQ(Milliseconds(50), throttle.nextSleep());
+}
+
+TEST(RangeDeletionThrottleTest, CopiesShareLastBatchSize) {
+    RAIIServerParameterControllerForTest maxBytesPerSecond{"rangeDeleterMaxBytesPerSecond", 1000};
+    const RangeDeletionThrottle throttle(Milliseconds(0));
+    const auto copy = throttle;
+
+    throttle.noteBatchDeleted(2000);
+    ASSERT_EQ(Milliseconds(2000), copy.nextSleep());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -56,6 +56,7 @@ constexpr auto kDocumentsCopied = "documentsCopied";
 constexpr auto kBytesToCopy = "approxBytesToCopy";
 constexpr auto kBytesCopied = "bytesCopied";
 constexpr auto kCopyTimeElapsed = "totalCopyTimeElapsedSecs";
+constexpr auto kIndexBuildTimeElapsed = "totalIndexBuildTimeElapsedSecs";
 constexpr auto kOplogsFetched = "oplogEntriesFetched";
 constexpr auto kOplogsApplied = "oplogEntriesApplied";
 constexpr auto kApplyTimeElapsed = "totalApplyTimeElapsedSecs";
@@ -220,6 +221,8 @@ public:
     int64_t bytesToCopy = 0;
     int64_t bytesCopied = 0;
 
+    TimeInterval buildingIndexes;
+
     TimeInterval applyingOplogEntries;
     int64_t oplogEntriesFetched = 0;
     int64_t oplogEntriesApplied = 0;
@@ -310,6 +313,7 @@ void ReshardingMetrics::OperationMetrics::appendCurrentOpMetrics(BSONObjBuilder*
             bob->append(kBytesToCopy, bytesToCopy);
             bob->append(kBytesCopied, bytesCopied);
             bob->append(kCopyTimeElapsed, getElapsedTime(copyingDocuments));
+            bob->append(kIndexBuildTimeElapsed, getElapsedTime(buildingIndexes));
 
             bob->append(kOplogsFetched, oplogEntriesFetched);
             bob->append(kOplogsApplied, oplogEntriesApplied);
@@ -625,6 +629,16 @@ void ReshardingMetrics::endCopyingDocuments(Date_t end) {
     _currentOp->copyingDocuments.forceEnd(end);
 }
 
+void ReshardingMetrics::startBuildingIndexes(Date_t start) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _currentOp->buildingIndexes.start(start);
+}
+
+void ReshardingMetrics::endBuildingIndexes(Date_t end) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _currentOp->buildingIndexes.forceEnd(end);
+}
+
 void ReshardingMetrics::startApplyingOplogEntries(Date_t start) {
     stdx::lock_guard<Latch> lk(_mutex);
     _currentOp->applyingOplogEntries.start(start);
@@ -100,6 +100,9 @@ public:
     void startCopyingDocuments(Date_t start);
     void endCopyingDocuments(Date_t end);
 
+    void startBuildingIndexes(Date_t start);
+    void endBuildingIndexes(Date_t end);
+
     void startApplyingOplogEntries(Date_t start);
     void endApplyingOplogEntries(Date_t end);
 
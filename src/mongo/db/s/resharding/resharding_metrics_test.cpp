@@ -574,6 +574,7 @@ TEST_F(ReshardingMetricsTest, CurrentOpReportForRecipient) {
                              "approxBytesToCopy: {8},"
                              "bytesCopied: {9},"
                              "totalCopyTimeElapsedSecs: {10},"
+                             "totalIndexBuildTimeElapsedSecs: 0,"
                              "oplogEntriesFetched: 0,"
                              "oplogEntriesApplied: 0,"
                              "totalApplyTimeElapsedSecs: 0,"
@@ -589,6 +589,17 @@ ReshardingRecipientService::RecipientStateMachine::_cloneThenTransitionToApplyin
 
     return future_util::withCancellation(_dataReplication->awaitCloningDone(), abortToken)
         .thenRunOn(**executor)
+        .then([this] {
+            _metrics()->endCopyingDocuments(getCurrentTime());
+
+            // Indexes deferred when creating the temporary resharding collection are built now
+            // that all of the documents have been inserted, and before oplog application starts.
+            auto opCtx = _cancelableOpCtxFactory->makeOperationContext(&cc());
+            _metrics()->startBuildingIndexes(getCurrentTime());
+            _externalState->buildTempReshardingCollectionIndexes(
+                opCtx.get(), _metadata, *_cloneTimestamp);
+            _metrics()->endBuildingIndexes(getCurrentTime());
+        })
         .then([this] { _transitionToApplying(); });
 }
 
@@ -766,9 +777,7 @@ void ReshardingRecipientService::RecipientStateMachine::_transitionToApplying()
     auto newRecipientCtx = _recipientCtx;
     newRecipientCtx.setState(RecipientStateEnum::kApplying);
     _transitionState(std::move(newRecipientCtx), boost::none, boost::none);
-    auto currentTime = getCurrentTime();
-    _metrics()->endCopyingDocuments(currentTime);
-    _metrics()->startApplyingOplogEntries(currentTime);
+    _metrics()->startApplyingOplogEntries(getCurrentTime());
 }
 
 void ReshardingRecipientService::RecipientStateMachine::_transitionToStrictConsistency() {
@@ -31,9 +31,17 @@
 
 #include "mongo/db/s/resharding/resharding_recipient_service_external_state.h"
 
+#include <algorithm>
+
+#include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/s/resharding/resharding_donor_recipient_common.h"
+#include "mongo/db/s/resharding/resharding_server_parameters_gen.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/grid.h"
@@ -41,6 +49,22 @@
 #include "mongo/s/stale_shard_version_helpers.h"
 
 namespace mongo {
+namespace {
+
+/**
+ * Returns true if the index can be built once the temporary resharding collection has been
+ * populated. The _id index is needed by ReshardingCollectionCloner to resume and an index prefixed
+ * by the new shard key may be used as the shard key index, so both are created up front. Hidden
+ * indexes cannot be requested on a system collection through the createIndexes command.
+ */
+bool canDeferIndexBuild(const KeyPattern& reshardingKey, const BSONObj& indexSpec) {
+    auto indexKey = indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName);
+    return !IndexDescriptor::isIdIndexPattern(indexKey) &&
+        !reshardingKey.toBSON().isPrefixOf(indexKey, SimpleBSONElementComparator::kInstance) &&
+        !indexSpec[IndexDescriptor::kHiddenFieldName].trueValue();
+}
+
+}  // namespace
 
 void ReshardingRecipientService::RecipientStateMachineExternalState::
     ensureTempReshardingCollectionExistsWithIndexes(OperationContext* opCtx,
@@ -69,6 +93,18 @@ void ReshardingRecipientService::RecipientStateMachineExternalState::
                              cloneTimestamp,
                              "loading indexes to create temporary resharding collection"_sd);
 
+    if (resharding::gReshardingRecipientDeferIndexBuilds.load()) {
+        // The remaining indexes are built by buildTempReshardingCollectionIndexes() after cloning
+        // so documents are inserted without maintaining them.
+        indexes.erase(std::remove_if(indexes.begin(),
+                                     indexes.end(),
+                                     [&](const BSONObj& indexSpec) {
+                                         return canDeferIndexBuild(metadata.getReshardingKey(),
+                                                                   indexSpec);
+                                     }),
+                      indexes.end());
+    }
+
     // Set the temporary resharding collection's UUID to the resharding UUID. Note that
     // BSONObj::addFields() replaces any fields that already exist.
     collOptions = collOptions.addFields(BSON("uuid" << metadata.getReshardingUUID()));
@@ -81,6 +117,52 @@ void ReshardingRecipientService::RecipientStateMachineExternalState::
                                     std::move(collOptions)});
 }
 
+void ReshardingRecipientService::RecipientStateMachineExternalState::
+    buildTempReshardingCollectionIndexes(OperationContext* opCtx,
+                                         const CommonReshardingMetadata& metadata,
+                                         Timestamp cloneTimestamp) {
+    auto [indexes, unusedIdIndex] =
+        getCollectionIndexes(opCtx,
+                             metadata.getSourceNss(),
+                             metadata.getSourceUUID(),
+                             cloneTimestamp,
+                             "loading indexes to build on temporary resharding collection"_sd);
+
+    if (indexes.empty()) {
+        return;
+    }
+
+    const auto& tempNss = metadata.getTempReshardingNss();
+    {
+        AutoGetCollection tempColl(opCtx, tempNss, MODE_IS);
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Temporary resharding collection " << tempNss
+                              << " does not exist",
+                tempColl);
+        indexes = tempColl->getIndexCatalog()->removeExistingIndexesNoChecks(
+            opCtx, *tempColl, indexes);
+    }
+
+    if (indexes.empty()) {
+        return;
+    }
+
+    LOGV2(7100400,
+          "Building indexes on temporary resharding collection",
+          "namespace"_attr = tempNss,
+          "reshardingUUID"_attr = metadata.getReshardingUUID(),
+          "numIndexes"_attr = indexes.size());
+
+    // All of the missing indexes are requested in a single createIndexes command so they are built
+    // together from one scan of the collection.
+    DBDirectClient client(opCtx);
+    BSONObj res;
+    client.runCommand(tempNss.db().toString(),
+                      BSON("createIndexes" << tempNss.coll() << "indexes" << indexes),
+                      res);
+    uassertStatusOK(getStatusFromCommandResult(res));
+}
+
 template <typename Callable>
 auto RecipientStateMachineExternalStateImpl::_withShardVersionRetry(OperationContext* opCtx,
                                                                     const NamespaceString& nss,
@@ -103,6 +103,15 @@ public:
     void ensureTempReshardingCollectionExistsWithIndexes(OperationContext* opCtx,
                                                          const CommonReshardingMetadata& metadata,
                                                          Timestamp cloneTimestamp);
+
+    /**
+     * Builds the indexes from the source collection which are missing on the temporary resharding
+     * collection. These are the indexes ensureTempReshardingCollectionExistsWithIndexes() skips
+     * when the reshardingRecipientDeferIndexBuilds server parameter is enabled.
+     */
+    void buildTempReshardingCollectionIndexes(OperationContext* opCtx,
+                                              const CommonReshardingMetadata& metadata,
+                                              Timestamp cloneTimestamp);
 };
 
 class RecipientStateMachineExternalStateImpl
@@ -33,14 +33,18 @@
 
 #include "mongo/db/storage/control/journal_flusher.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/integer_histogram.h"
 
 namespace mongo {
 
@@ -51,6 +55,44 @@ const auto getJournalFlusher = ServiceContext::declareDecoration<std::unique_ptr
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherBeforeFlush);
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherThread);
 
+// Rounds that released at least one waiter, the waiters they released, and how many of those rounds
+// were held open for more waiters to join.
+Counter64 groupCommitRounds;
+Counter64 groupCommitWaiters;
+Counter64 groupCommitDelayedRounds;
+
+ServerStatusMetricField<Counter64> displayGroupCommitRounds("journalFlusher.groupCommit.rounds",
+                                                            &groupCommitRounds);
+ServerStatusMetricField<Counter64> displayGroupCommitWaiters("journalFlusher.groupCommit.waiters",
+                                                             &groupCommitWaiters);
+ServerStatusMetricField<Counter64> displayGroupCommitDelayedRounds(
+    "journalFlusher.groupCommit.delayedRounds", &groupCommitDelayedRounds);
+
+// Time callers of waitForJournalFlush() spend waiting for their writes to become durable, in
+// microseconds.
+constexpr std::array<int64_t, 9> kDurabilityWaitLowerBoundsMicros{
+    0, 100, 500, 1000, 5000, 10000, 50000, 100000, 1000000};
+
+IntegerHistogram<kDurabilityWaitLowerBoundsMicros.size()> durabilityWaitMicros(
+    "durabilityWaitMicros", kDurabilityWaitLowerBoundsMicros);
+
+class DurabilityWaitLatencyMetric : public ServerStatusMetric {
+public:
+    DurabilityWaitLatencyMetric() : ServerStatusMetric("journalFlusher.waitLatency") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const override {
+        BSONObjBuilder latencyBuilder(b.subobjStart(_leafName));
+        durabilityWaitMicros.append(latencyBuilder, true);
+    }
+} durabilityWaitLatencyMetric;
+
+/**
+ * Folds 'sample' into the moving average 'avg', weighting the sample by 1/8.
+ */
+void updateMovingAverage(Microseconds* avg, Microseconds sample) {
+    *avg += (sample - *avg) / 8;
+}
+
 }  // namespace
 
 JournalFlusher* JournalFlusher::get(ServiceContext* serviceCtx) {
@@ -111,7 +153,12 @@ void JournalFlusher::run() {
                 _uniqueCtx->get()->setShouldParticipateInFlowControl(false);
             });
 
+            Timer flushTimer;
             _uniqueCtx->get()->recoveryUnit()->waitUntilDurable(_uniqueCtx->get());
+            {
+                stdx::lock_guard<Latch> lk(_stateMutex);
+                updateMovingAverage(&_avgFlushDuration, Microseconds(flushTimer.micros()));
+            }
 
             // Signal the waiters that a round completed.
             _currentSharedPromise->emplaceValue();
@@ -169,6 +216,25 @@ void JournalFlusher::run() {
             _stateChangeCV.notify_all();
         }
 
+        // Hold a round that waiters asked for open while more waiters are expected to join it, so
+        // that they share its journal sync instead of each needing a round of their own. The wait
+        // ends early once the expected number of waiters has arrived.
+        if (_flushJournalNow && _nextRoundWaiters > 0 && !_needToPause && !_shuttingDown) {
+            if (auto delay = _groupCommitDelay(); delay > Microseconds(0)) {
+                const auto expectedWaiters = _nextRoundWaiters +
+                    delay.count() / std::max<int64_t>(_avgWaiterInterArrival.count(), 1);
+                groupCommitDelayedRounds.increment();
+
+                _holdingRoundOpen = true;
+                _flushJournalNowCV.wait_until(
+                    lk, (Date_t::now() + delay).toSystemTimePoint(), [&] {
+                        return _nextRoundWaiters >= expectedWaiters || _needToPause ||
+                            _shuttingDown;
+                    });
+                _holdingRoundOpen = false;
+            }
+        }
+
         _flushJournalNow = false;
 
         if (_shuttingDown) {
@@ -187,6 +253,10 @@ void JournalFlusher::run() {
         // Take the next promise as current and reset the next promise.
         _currentSharedPromise =
             std::exchange(_nextSharedPromise, std::make_unique<SharedPromise<void>>());
+        if (auto roundWaiters = std::exchange(_nextRoundWaiters, 0)) {
+            groupCommitRounds.increment();
+            groupCommitWaiters.increment(roundWaiters);
+        }
     }
 }
 
@@ -232,12 +302,18 @@ void JournalFlusher::triggerJournalFlush() {
 }
 
 void JournalFlusher::waitForJournalFlush() {
+    Timer waitTimer;
+    ON_BLOCK_EXIT([&] { durabilityWaitMicros.increment(waitTimer.micros()); });
+
+    // A caller is counted as a waiter once, however many rounds it has to wait for.
+    bool isRetry = false;
     while (true) {
         try {
-            _waitForJournalFlushNoRetry();
+            _waitForJournalFlushNoRetry(!isRetry);
             break;
         } catch (const ExceptionFor<ErrorCodes::InterruptedDueToReplStateChange>&) {
-            // Do nothing and let the while-loop retry the operation.
+            // Let the while-loop retry the operation.
+            isRetry = true;
             LOGV2_DEBUG(4814901,
                         3,
                         "Retrying waiting for durability interrupted by replication state change");
@@ -253,10 +329,18 @@ void JournalFlusher::interruptJournalFlusherForReplStateChange() {
     }
 }
 
-void JournalFlusher::_waitForJournalFlushNoRetry() {
+void JournalFlusher::_waitForJournalFlushNoRetry(bool countWaiter) {
     auto myFuture = [&]() {
         stdx::unique_lock<Latch> lk(_stateMutex);
-        if (!_flushJournalNow) {
+        if (countWaiter) {
+            updateMovingAverage(&_avgWaiterInterArrival,
+                                std::min(Microseconds(_sinceLastWaiter.micros()),
+                                         Microseconds(kMaxWaiterInterArrival)));
+            _sinceLastWaiter.reset();
+            ++_nextRoundWaiters;
+        }
+
+        if (!_flushJournalNow || _holdingRoundOpen) {
             _flushJournalNow = true;
             _flushJournalNowCV.notify_one();
         }
@@ -266,4 +350,15 @@ void JournalFlusher::_waitForJournalFlushNoRetry() {
     myFuture.get();
 }
 
+Microseconds JournalFlusher::_groupCommitDelay() const {
+    // Holding a round open for longer than a flush takes would cost more latency than running the
+    // waiters in a round of their own.
+    const auto maxDelay = std::min(Microseconds(gJournalGroupCommitMaxDelayMicros.load()),
+                                   _avgFlushDuration);
+    if (_avgWaiterInterArrival >= maxDelay) {
+        return Microseconds(0);
+    }
+    return maxDelay;
+}
+
 }  // namespace mongo
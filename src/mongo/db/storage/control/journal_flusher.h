@@ -33,6 +33,7 @@
 #include "mongo/platform/mutex.h"
 #include "mongo/util/background.h"
 #include "mongo/util/future.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -130,12 +131,20 @@ private:
     };
 
     /**
-     * Signals an immediate journal flush and waits for it to complete before returning.
+     * Signals an immediate journal flush and waits for it to complete before returning. Counts the
+     * caller as a waiter of the next round, for group commit, only if 'countWaiter' is true.
      *
      * Will throw ErrorCodes::isShutdownError if the flusher thread is being stopped.
      * Will throw InterruptedDueToReplStateChange if a flusher round is interrupted by stepdown.
      */
-    void _waitForJournalFlushNoRetry();
+    void _waitForJournalFlushNoRetry(bool countWaiter);
+
+    /**
+     * Returns how long a requested round should be held open for more waiters to join before it
+     * flushes, based on the recent waiter arrival rate and flush duration. Returns zero when
+     * waiters arrive too slowly to be worth batching. Must be called with _stateMutex held.
+     */
+    Microseconds _groupCommitDelay() const;
 
     // Serializes setting/resetting _uniqueCtx and marking _uniqueCtx killed.
     mutable Mutex _opCtxMutex = MONGO_MAKE_LATCH("JournalFlusherOpCtxMutex");
@@ -170,6 +179,24 @@ private:
     std::unique_ptr<SharedPromise<void>> _nextSharedPromise =
         std::make_unique<SharedPromise<void>>();
 
+    // Longer gaps between waiter arrivals are averaged as this value, so that idle periods are
+    // forgotten quickly.
+    static constexpr Seconds kMaxWaiterInterArrival{1};
+
+    // Number of waiters on _nextSharedPromise, i.e. the waiters the next round will release.
+    int _nextRoundWaiters = 0;
+
+    // Set while the thread holds a requested round open for more waiters to join, so that arriving
+    // waiters wake it up to re-evaluate whether the round is full.
+    bool _holdingRoundOpen = false;
+
+    // Moving averages of the time between consecutive waiter arrivals and of the time a round
+    // spends flushing, used to size the group commit delay. _sinceLastWaiter measures the time
+    // since the most recent waiter arrived.
+    Microseconds _avgWaiterInterArrival = kMaxWaiterInterArrival;
+    Microseconds _avgFlushDuration{0};
+    Timer _sinceLastWaiter;
+
     // Controls whether to ignore the 'storageGlobalParams.journalCommitIntervalMs' setting. If set,
     // data flushes will only be executed upon explicit request, no longer periodically in addition
     // to upon request.
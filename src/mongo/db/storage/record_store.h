@@ -516,6 +516,13 @@ public:
      */
     virtual void waitForAllEarlierOplogWritesToBeVisible(OperationContext* opCtx) const = 0;
 
+    /**
+     * Called on an oplog when a tailing reader is about to block waiting for new entries to become
+     * visible. Storage engines that batch oplog visibility updates may use this to publish pending
+     * entries immediately rather than after their batching delay.
+     */
+    virtual void notifyOplogReaderWaiting() const {}
+
     /**
      * Called after a repair operation is run with the recomputed numRecords and dataSize.
      */
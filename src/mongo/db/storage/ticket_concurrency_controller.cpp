@@ -0,0 +1,201 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/ticket_concurrency_controller.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/ticket_concurrency_controller_parameters_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/ticketholder.h"
+
+namespace mongo {
+
+StringData toString(TicketConcurrencyController::Decision decision) {
+    switch (decision) {
+        case TicketConcurrencyController::Decision::kNone:
+            return "none"_sd;
+        case TicketConcurrencyController::Decision::kIdle:
+            return "idle"_sd;
+        case TicketConcurrencyController::Decision::kHold:
+            return "hold"_sd;
+        case TicketConcurrencyController::Decision::kIncrease:
+            return "increase"_sd;
+        case TicketConcurrencyController::Decision::kDecrease:
+            return "decrease"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+TicketConcurrencyController::TicketConcurrencyController(std::string name, TicketHolder* holder)
+    : _name(std::move(name)), _holder(holder) {}
+
+TicketConcurrencyController::~TicketConcurrencyController() {
+    stop();
+}
+
+void TicketConcurrencyController::start(ServiceContext* service) {
+    _job = service->getPeriodicRunner()->makeJob(
+        {"TicketConcurrencyController-" + _name,
+         [this](Client*) { adjust(Date_t::now()); },
+         Milliseconds(gAdaptiveTicketConcurrencyIntervalMillis)});
+    _job.start();
+}
+
+void TicketConcurrencyController::stop() {
+    if (_job) {
+        _job.stop();
+        _job.detach();
+    }
+}
+
+void TicketConcurrencyController::adjust(Date_t now) {
+    const auto released = _holder->totalReleased();
+    const auto queued = _holder->totalQueued();
+    const int current = _holder->outof();
+
+    double throughput;
+    bool saturated;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        const auto lastSampleTime = _lastSampleTime;
+        const auto lastReleased = _lastReleased;
+        const auto lastQueued = _lastQueued;
+        _lastSampleTime = now;
+        _lastReleased = released;
+        _lastQueued = queued;
+
+        if (!lastSampleTime || now <= *lastSampleTime) {
+            return;
+        }
+
+        throughput = static_cast<double>(released - lastReleased) * 1000 /
+            durationCount<Milliseconds>(now - *lastSampleTime);
+        saturated = queued != lastQueued;
+    }
+
+    const int target = computeTarget(current, throughput, saturated);
+    if (target == current) {
+        return;
+    }
+
+    auto status = _holder->resize(target);
+    if (!status.isOK()) {
+        LOGV2_DEBUG(7100504,
+                    1,
+                    "Could not resize ticket pool",
+                    "pool"_attr = _name,
+                    "from"_attr = current,
+                    "to"_attr = target,
+                    "error"_attr = status);
+        return;
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _lastAdjustment = now;
+    }
+
+    LOGV2_DEBUG(7100505,
+                1,
+                "Resized ticket pool",
+                "pool"_attr = _name,
+                "from"_attr = current,
+                "to"_attr = target,
+                "throughput"_attr = throughput);
+}
+
+int TicketConcurrencyController::computeTarget(int current, double throughput, bool saturated) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _lastObservedThroughput = throughput;
+
+    if (!saturated) {
+        // Nobody waited for a ticket, so more tickets would not have helped. Forget the last
+        // throughput since it was not limited by concurrency either.
+        _lastThroughput = boost::none;
+        _lastDecision = Decision::kIdle;
+        return current;
+    }
+
+    const double tolerance = gAdaptiveTicketConcurrencyTolerancePercentage.load() / 100.0;
+    if (_lastThroughput) {
+        if (throughput < *_lastThroughput * (1 - tolerance)) {
+            // The last step made things worse, so step back the other way.
+            _direction = -_direction;
+        } else if (throughput <= *_lastThroughput * (1 + tolerance)) {
+            _lastThroughput = throughput;
+            _lastDecision = Decision::kHold;
+            return current;
+        }
+    }
+    _lastThroughput = throughput;
+
+    const int minTickets = gAdaptiveTicketConcurrencyMinTickets.load();
+    const int maxTickets = std::max(minTickets, gAdaptiveTicketConcurrencyMaxTickets.load());
+    const int step =
+        std::max(1, current * gAdaptiveTicketConcurrencyStepPercentage.load() / 100);
+    const int target = std::clamp(current + _direction * step, minTickets, maxTickets);
+
+    if (target > current) {
+        _lastDecision = Decision::kIncrease;
+        ++_numIncreases;
+    } else if (target < current) {
+        _lastDecision = Decision::kDecrease;
+        ++_numDecreases;
+    } else {
+        _lastDecision = Decision::kHold;
+        return current;
+    }
+    return target;
+}
+
+TicketConcurrencyController::Decision TicketConcurrencyController::getLastDecision() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _lastDecision;
+}
+
+void TicketConcurrencyController::appendStats(BSONObjBuilder* b) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    b->append("lastDecision", toString(_lastDecision));
+    b->append("lastThroughput", _lastObservedThroughput);
+    b->append("increases", _numIncreases);
+    b->append("decreases", _numDecreases);
+    if (_lastAdjustment != Date_t()) {
+        b->append("lastAdjustment", _lastAdjustment);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+
+#include "mongo/platform/mutex.h"
+#include "mongo/util/periodic_runner.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class ServiceContext;
+class TicketHolder;
+
+/**
+ * Periodically resizes a TicketHolder by hill climbing on its throughput, measured as tickets
+ * released per second. While operations are queueing for tickets, the controller keeps moving the
+ * pool size in one direction as long as throughput improves, and reverses direction when it
+ * degrades. Changes within the tolerance are treated as noise and leave the size alone. When
+ * nobody is queueing, concurrency isn't the bottleneck and the size is also left alone.
+ *
+ * Every decision is reported through appendStats() so that it is captured in FTDC.
+ */
+class TicketConcurrencyController {
+    TicketConcurrencyController(const TicketConcurrencyController&) = delete;
+    TicketConcurrencyController& operator=(const TicketConcurrencyController&) = delete;
+
+public:
+    enum class Decision { kNone, kIdle, kHold, kIncrease, kDecrease };
+
+    TicketConcurrencyController(std::string name, TicketHolder* holder);
+    ~TicketConcurrencyController();
+
+    /**
+     * Starts a periodic job that calls adjust() every adaptiveTicketConcurrencyIntervalMillis.
+     */
+    void start(ServiceContext* service);
+
+    /**
+     * Stops the periodic job, if started. The ticket holder keeps its current size.
+     */
+    void stop();
+
+    /**
+     * Samples the ticket holder and resizes it if warranted.
+     */
+    void adjust(Date_t now);
+
+    /**
+     * Appends the most recent decision and the number of adjustments made so far.
+     */
+    void appendStats(BSONObjBuilder* b) const;
+
+    /**
+     * Returns the size the ticket pool should have after an interval in which 'throughput'
+     * tickets were released per second, given its current size and whether operations had to
+     * queue. Records the decision. Exposed for testing.
+     */
+    int computeTarget(int current, double throughput, bool saturated);
+
+    Decision getLastDecision() const;
+
+private:
+    const std::string _name;
+    TicketHolder* const _holder;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("TicketConcurrencyController::_mutex");
+
+    // The previous sample of the holder's counters, used to compute rates over the interval.
+    boost::optional<Date_t> _lastSampleTime;
+    long long _lastReleased = 0;
+    long long _lastQueued = 0;
+
+    // The throughput of the last saturated interval, compared against to pick a direction.
+    boost::optional<double> _lastThroughput;
+    int _direction = 1;
+
+    Decision _lastDecision = Decision::kNone;
+    double _lastObservedThroughput = 0;
+    Date_t _lastAdjustment;
+    long long _numIncreases = 0;
+    long long _numDecreases = 0;
+
+    PeriodicJobAnchor _job;
+};
+
+StringData toString(TicketConcurrencyController::Decision decision);
+
+}  // namespace mongo
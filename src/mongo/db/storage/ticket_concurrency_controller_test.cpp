@@ -0,0 +1,168 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/ticket_concurrency_controller.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+using Decision = TicketConcurrencyController::Decision;
+
+TEST(TicketConcurrencyControllerTest, LeavesSizeAloneWhenNobodyQueues) {
+    TicketHolder holder(100);
+    TicketConcurrencyController controller("test", &holder);
+
+    ASSERT_EQ(controller.computeTarget(100, 1000, false), 100);
+    ASSERT(controller.getLastDecision() == Decision::kIdle);
+}
+
+TEST(TicketConcurrencyControllerTest, GrowsWhileThroughputImproves) {
+    TicketHolder holder(100);
+    TicketConcurrencyController controller("test", &holder);
+
+    ASSERT_EQ(controller.computeTarget(100, 1000, true), 110);
+    ASSERT(controller.getLastDecision() == Decision::kIncrease);
+    ASSERT_EQ(controller.computeTarget(110, 1200, true), 121);
+    ASSERT(controller.getLastDecision() == Decision::kIncrease);
+}
+
+TEST(TicketConcurrencyControllerTest, ReversesWhenThroughputDegrades) {
+    TicketHolder holder(100);
+    TicketConcurrencyController controller("test", &holder);
+
+    ASSERT_EQ(controller.computeTarget(100, 1000, true), 110);
+    ASSERT_EQ(controller.computeTarget(110, 800, true), 99);
+    ASSERT(controller.getLastDecision() == Decision::kDecrease);
+
+    // Shrinking helped, so keep shrinking.
+    ASSERT_EQ(controller.computeTarget(99, 1000, true), 90);
+    ASSERT(controller.getLastDecision() == Decision::kDecrease);
+}
+
+TEST(TicketConcurrencyControllerTest, HoldsWithinTolerance) {
+    RAIIServerParameterControllerForTest tolerance{"adaptiveTicketConcurrencyTolerancePercentage",
+                                                   5};
+    TicketHolder holder(100);
+    TicketConcurrencyController controller("test", &holder);
+
+    ASSERT_EQ(controller.computeTarget(100, 1000, true), 110);
+    ASSERT_EQ(controller.computeTarget(110, 1040, true), 110);
+    ASSERT(controller.getLastDecision() == Decision::kHold);
+    ASSERT_EQ(controller.computeTarget(110, 1000, true), 110);
+    ASSERT(controller.getLastDecision() == Decision::kHold);
+}
+
+TEST(TicketConcurrencyControllerTest, StaysWithinBounds) {
+    RAIIServerParameterControllerForTest minTickets{"adaptiveTicketConcurrencyMinTickets", 95};
+    RAIIServerParameterControllerForTest maxTickets{"adaptiveTicketConcurrencyMaxTickets", 105};
+    TicketHolder holder(100);
+    TicketConcurrencyController controller("test", &holder);
+
+    ASSERT_EQ(controller.computeTarget(100, 1000, true), 105);
+    ASSERT_EQ(controller.computeTarget(105, 2000, true), 105);
+    ASSERT(controller.getLastDecision() == Decision::kHold);
+
+    ASSERT_EQ(controller.computeTarget(105, 500, true), 95);
+    ASSERT_EQ(controller.computeTarget(95, 1000, true), 95);
+    ASSERT(controller.getLastDecision() == Decision::kHold);
+}
+
+TEST(TicketConcurrencyControllerTest, AdjustResizesSaturatedHolder) {
+    TicketHolder holder(20);
+    TicketConcurrencyController controller("test", &holder);
+    const auto start = Date_t::now();
+
+    // The first sample only establishes a baseline.
+    controller.adjust(start);
+    ASSERT(controller.getLastDecision() == Decision::kNone);
+
+    for (int i = 0; i < 20; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+    ASSERT_FALSE(holder.waitForTicketUntil(Date_t::now()));
+    for (int i = 0; i < 20; ++i) {
+        holder.release();
+    }
+
+    controller.adjust(start + Seconds(1));
+    ASSERT(controller.getLastDecision() == Decision::kIncrease);
+    ASSERT_EQ(holder.outof(), 22);
+    ASSERT_EQ(holder.available(), 22);
+
+    // Nobody queued in the next interval, so the size is left alone.
+    controller.adjust(start + Seconds(2));
+    ASSERT(controller.getLastDecision() == Decision::kIdle);
+    ASSERT_EQ(holder.outof(), 22);
+
+    BSONObjBuilder builder;
+    controller.appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["lastDecision"].str(), "idle");
+    ASSERT_EQ(stats["increases"].numberLong(), 1);
+    ASSERT_EQ(stats["decreases"].numberLong(), 0);
+    ASSERT_EQ(stats["lastThroughput"].numberDouble(), 0);
+    ASSERT_EQ(stats["lastAdjustment"].date(), start + Seconds(1));
+}
+
+#if defined(__linux__)
+TEST(TicketConcurrencyControllerTest, ShrinkingIsNotMistakenForSaturation) {
+    TicketHolder holder(20);
+    TicketConcurrencyController controller("test", &holder);
+    const auto start = Date_t::now();
+    controller.adjust(start);
+
+    // Shrinking while every ticket is in use has to wait for one to be released.
+    for (int i = 0; i < 20; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+    auto resizer = stdx::thread([&] { ASSERT_OK(holder.resize(19)); });
+    sleepmillis(2);
+    holder.release();
+    resizer.join();
+    for (int i = 0; i < 19; ++i) {
+        holder.release();
+    }
+
+    controller.adjust(start + Seconds(1));
+    ASSERT(controller.getLastDecision() == Decision::kIdle);
+    ASSERT_EQ(holder.outof(), 19);
+}
+#endif
+
+}  // namespace
+}  // namespace mongo
@@ -94,6 +94,8 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
+#include "mongo/db/storage/ticket_concurrency_controller.h"
+#include "mongo/db/storage/ticket_concurrency_controller_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_backup_cursor_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
@@ -845,6 +847,15 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
 
+    if (gAdaptiveTicketConcurrencyEnabled && !_readOnly) {
+        _readTicketController =
+            std::make_unique<TicketConcurrencyController>("read", &openReadTransaction);
+        _writeTicketController =
+            std::make_unique<TicketConcurrencyController>("write", &openWriteTransaction);
+        _readTicketController->start(getGlobalServiceContext());
+        _writeTicketController->start(getGlobalServiceContext());
+    }
+
     _runTimeConfigParam.reset(new WiredTigerEngineRuntimeConfigParameter(
         "wiredTigerEngineRuntimeConfig", ServerParameterType::kRuntimeOnly));
     _runTimeConfigParam->_data.second = this;
@@ -870,16 +881,20 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
     BSONObjBuilder bb(b.subobjStart("concurrentTransactions"));
     {
         BSONObjBuilder bbb(bb.subobjStart("write"));
-        bbb.append("out", openWriteTransaction.used());
-        bbb.append("available", openWriteTransaction.available());
-        bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction.appendStats(&bbb);
+        if (_writeTicketController) {
+            BSONObjBuilder adaptive(bbb.subobjStart("adaptive"));
+            _writeTicketController->appendStats(&adaptive);
+        }
         bbb.done();
     }
     {
         BSONObjBuilder bbb(bb.subobjStart("read"));
-        bbb.append("out", openReadTransaction.used());
-        bbb.append("available", openReadTransaction.available());
-        bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction.appendStats(&bbb);
+        if (_readTicketController) {
+            BSONObjBuilder adaptive(bbb.subobjStart("adaptive"));
+            _readTicketController->appendStats(&adaptive);
+        }
         bbb.done();
     }
     bb.done();
@@ -987,6 +1002,11 @@ void WiredTigerKVEngine::cleanShutdown() {
         return;
     }
 
+    if (_readTicketController) {
+        _readTicketController->stop();
+        _writeTicketController->stop();
+    }
+
     // these must be the last things we do before _conn->close();
     haltOplogManager(/*oplogRecordStore=*/nullptr, /*shuttingDown=*/true);
     if (_sessionSweeper) {
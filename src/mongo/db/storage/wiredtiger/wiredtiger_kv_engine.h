@@ -54,6 +54,7 @@ namespace mongo {
 
 class ClockSource;
 class JournalListener;
+class TicketConcurrencyController;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
@@ -486,6 +487,10 @@ private:
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
 
+    // Resize the read and write ticket pools when adaptiveTicketConcurrencyEnabled is set.
+    std::unique_ptr<TicketConcurrencyController> _readTicketController;
+    std::unique_ptr<TicketConcurrencyController> _writeTicketController;
+
     std::string _rsOptions;
     std::string _indexOptions;
 
@@ -118,6 +118,13 @@ void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
     }
 }
 
+void WiredTigerOplogManager::notifyOplogReaderWaiting() {
+    stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    if (_triggerOplogVisibilityUpdate) {
+        _oplogVisibilityThreadCV.notify_one();
+    }
+}
+
 void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     const WiredTigerRecordStore* oplogRecordStore, OperationContext* opCtx) {
     invariant(opCtx->lockState()->isNoop() || !opCtx->lockState()->inAWriteUnitOfWork());
@@ -149,6 +156,9 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     ++_opsWaitingForOplogVisibilityUpdate;
     invariant(_opsWaitingForOplogVisibilityUpdate > 0);
     auto exitGuard = makeGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
+    if (_triggerOplogVisibilityUpdate) {
+        _oplogVisibilityThreadCV.notify_one();
+    }
 
     // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
     // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
@@ -200,21 +210,18 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
 
             // If we are not shutting down and nobody is actively waiting for the oplog to become
             // visible, delay a bit to batch more requests into one update and reduce system load.
-            auto now = Date_t::now();
-            auto deadline = now + Milliseconds(kDelayMillis);
+            auto deadline = Date_t::now() + Milliseconds(kDelayMillis);
 
             auto wakeUpEarlyForWaitersPredicate = [&] {
                 return _shuttingDown || _opsWaitingForOplogVisibilityUpdate ||
                     oplogRecordStore->haveCappedWaiters();
             };
 
-            // Check once a millisecond, up to the delay deadline, whether the delay should be
-            // preempted because of waiting callers or shutdown.
-            while (now < deadline &&
-                   !_oplogVisibilityThreadCV.wait_until(
-                       lk, now.toSystemTimePoint(), wakeUpEarlyForWaitersPredicate)) {
-                now += Milliseconds(1);
-            }
+            // Callers that start waiting during the delay, either for visibility or as tailing
+            // oplog readers, signal '_oplogVisibilityThreadCV' to preempt it. Readers that were
+            // already waiting are caught by the predicate up front.
+            _oplogVisibilityThreadCV.wait_until(
+                lk, deadline.toSystemTimePoint(), wakeUpEarlyForWaitersPredicate);
         }
 
         while (!_shuttingDown && MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail())) {
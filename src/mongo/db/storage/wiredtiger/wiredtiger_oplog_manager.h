@@ -79,6 +79,12 @@ public:
      */
     void triggerOplogVisibilityUpdate();
 
+    /**
+     * Wakes the oplog visibility thread if it is delaying a scheduled update, so that entries a
+     * tailing oplog reader is about to wait for are published without the batching delay.
+     */
+    void notifyOplogReaderWaiting();
+
     /**
      * Waits for all committed writes at this time to become visible (that is, until no holes exist
      * in the oplog up to the time we start waiting.)
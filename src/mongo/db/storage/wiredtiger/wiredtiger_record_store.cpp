@@ -1723,6 +1723,11 @@ void WiredTigerRecordStore::waitForAllEarlierOplogWritesToBeVisible(OperationCon
     }
 }
 
+void WiredTigerRecordStore::notifyOplogReaderWaiting() const {
+    invariant(_isOplog);
+    _kvEngine->getOplogManager()->notifyOplogReaderWaiting();
+}
+
 void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
                                                    long long numRecords,
                                                    long long dataSize) {
@@ -204,6 +204,8 @@ public:
 
     void waitForAllEarlierOplogWritesToBeVisible(OperationContext* opCtx) const override;
 
+    void notifyOplogReaderWaiting() const override;
+
     Status updateOplogSize(long long newOplogSize) final;
 
     void setCappedCallback(CappedCallback* cb) {
@@ -179,6 +179,10 @@ private:
         const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
         OperationContext* opCtx = opCtxPtr.get();
 
+        // TTL deletes are background work and should not delay user writes when the system is out
+        // of write tickets.
+        opCtx->lockState()->setAdmissionPriority(AdmissionPriority::kLow);
+
         // If part of replSet but not in a readable state (e.g. during initial sync), skip.
         if (repl::ReplicationCoordinator::get(opCtx)->getReplicationMode() ==
                 repl::ReplicationCoordinator::modeReplSet &&
@@ -53,6 +53,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/protocol.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/integer_histogram.h"
 
 namespace mongo {
 
@@ -75,6 +76,33 @@ static Counter64 gleDefaultUnsatisfiable;
 static ServerStatusMetricField<Counter64> gleDefaultUnsatisfiableDisplay(
     "getLastError.default.unsatisfiable", &gleDefaultUnsatisfiable);
 
+namespace {
+
+// Latency breakdown of w:"majority" write concern waits, in microseconds. 'journalWaitMicros' is
+// the time spent making the write durable locally and 'replicationWaitMicros' is the time spent
+// waiting for the majority commit point to reach the write, including waits that timed out or
+// were interrupted.
+constexpr std::array<int64_t, 9> kMajorityWaitLowerBoundsMicros{
+    0, 100, 500, 1000, 5000, 10000, 50000, 100000, 1000000};
+
+IntegerHistogram<kMajorityWaitLowerBoundsMicros.size()> majorityJournalWaitMicros(
+    "journalWaitMicros", kMajorityWaitLowerBoundsMicros);
+IntegerHistogram<kMajorityWaitLowerBoundsMicros.size()> majorityReplicationWaitMicros(
+    "replicationWaitMicros", kMajorityWaitLowerBoundsMicros);
+
+class MajorityWaitLatencyMetric : public ServerStatusMetric {
+public:
+    MajorityWaitLatencyMetric() : ServerStatusMetric("getLastError.majorityWaitLatency") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const override {
+        BSONObjBuilder latencyBuilder(b.subobjStart(_leafName));
+        majorityJournalWaitMicros.append(latencyBuilder, true);
+        majorityReplicationWaitMicros.append(latencyBuilder, true);
+    }
+} majorityWaitLatencyMetric;
+
+}  // namespace
+
 MONGO_FAIL_POINT_DEFINE(hangBeforeWaitingForWriteConcern);
 
 bool commandSpecifiesWriteConcern(const BSONObj& cmdObj) {
@@ -315,6 +343,10 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     result->syncMillis = syncTimer.millis();
+    const bool isMajority = writeConcern.wMode == WriteConcernOptions::kMajority;
+    if (isMajority) {
+        majorityJournalWaitMicros.increment(syncTimer.micros());
+    }
 
     // Now wait for replication
 
@@ -330,8 +362,12 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     // Replica set stepdowns and gle mode changes are thrown as errors
+    Timer replTimer;
     repl::ReplicationCoordinator::StatusAndDuration replStatus =
         replCoord->awaitReplication(opCtx, replOpTime, writeConcernWithPopulatedSyncMode);
+    if (isMajority) {
+        majorityReplicationWaitMicros.increment(replTimer.micros());
+    }
     if (replStatus.status == ErrorCodes::WriteConcernFailed) {
         gleWtimeouts.increment();
         if (!writeConcern.getProvenance().isClientSupplied()) {
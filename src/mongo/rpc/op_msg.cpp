@@ -67,6 +67,25 @@ enum class Section : uint8_t {
 
 constexpr int kCrc32Size = 4;
 
+/**
+ * Returns the number of documents in a document sequence by walking their length prefixes without
+ * validating them, so that the sequence's vector can be sized once. Stops counting at the first
+ * length that doesn't fit, leaving it to the validating pass to reject the message.
+ */
+size_t countDocumentsInSequence(const char* data, size_t size) {
+    size_t count = 0;
+    while (size >= sizeof(int32_t)) {
+        const int32_t docSize = ConstDataView(data).read<LittleEndian<int32_t>>();
+        if (docSize < BSONObj::kMinBSONLength || static_cast<size_t>(docSize) > size) {
+            break;
+        }
+        data += docSize;
+        size -= docSize;
+        ++count;
+    }
+    return count;
+}
+
 #ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
 // All fields including size, requestId, and responseTo must already be set. The size must already
 // include the final 4-byte checksum.
@@ -184,8 +203,11 @@ OpMsg OpMsg::parse(const Message& message) try {
                         !msg.getSequence(name));  // TODO IDL
 
                 msg.sequences.push_back({name.toString()});
+                auto& objs = msg.sequences.back().objs;
+                objs.reserve(countDocumentsInSequence(static_cast<const char*>(seqBuf.pos()),
+                                                      seqBuf.remaining()));
                 while (!seqBuf.atEof()) {
-                    msg.sequences.back().objs.push_back(seqBuf.read<Validated<BSONObj>>());
+                    objs.push_back(seqBuf.read<Validated<BSONObj>>());
                 }
                 break;
             }
@@ -104,6 +104,40 @@ TEST_F(OpMsgParser, SucceedsWithBodyThenSequence) {
     ASSERT_BSONOBJ_EQ(msg.sequences[0].objs[1], fromjson("{a: 2}"));
 }
 
+TEST_F(OpMsgParser, SequenceDocumentsAreViewsSizedOnce) {
+    auto message =
+        OpMsgBytes{
+            kNoFlags,  //
+            kBodySection,
+            fromjson("{insert: 'coll'}"),
+
+            kDocSequenceSection,
+            Sized{
+                "documents",  //
+                fromjson("{_id: 1}"),
+                fromjson("{_id: 2}"),
+                fromjson("{_id: 3}"),
+                fromjson("{_id: 4}"),
+                fromjson("{_id: 5}"),
+            },
+        }
+            .done();
+
+    auto msg = OpMsg::parse(message);
+    ASSERT_EQ(msg.sequences.size(), 1u);
+    const auto& objs = msg.sequences[0].objs;
+    ASSERT_EQ(objs.size(), 5u);
+    ASSERT_EQ(objs.capacity(), objs.size());
+
+    const char* begin = message.buf();
+    const char* end = begin + message.size();
+    for (size_t i = 0; i < objs.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(objs[i], BSON("_id" << static_cast<int>(i + 1)));
+        ASSERT_GTE(objs[i].objdata(), begin);
+        ASSERT_LT(objs[i].objdata(), end);
+    }
+}
+
 TEST_F(OpMsgParser, SucceedsWithSequenceThenBody) {
     auto msg =
         OpMsgBytes{
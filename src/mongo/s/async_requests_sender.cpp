@@ -43,6 +43,8 @@
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/hedge_options_util.h"
+#include "mongo/s/mongos_server_parameters_gen.h"
+#include "mongo/s/replica_latency_tracker.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
@@ -176,6 +178,13 @@ auto AsyncRequestsSender::RemoteData::scheduleRequest()
     return resolveShardIdToHostAndPorts(_ars->_readPreference)
         .thenRunOn(*_ars->_subBaton)
         .then([this](auto&& hostAndPorts) {
+            if (gReadAdaptiveReplicaSelection.load()) {
+                ReplicaLatencyTracker::get(_ars->_opCtx->getServiceContext())
+                    ->orderByExpectedLatency(
+                        &hostAndPorts,
+                        Date_t::now(),
+                        Milliseconds(gAdaptiveReplicaSelectionSampleExpirationMS.load()));
+            }
             _shardHostAndPort.emplace(hostAndPorts.front());
             return scheduleRemoteCommand(std::move(hostAndPorts));
         })
@@ -212,6 +221,7 @@ auto AsyncRequestsSender::RemoteData::scheduleRemoteCommand(std::vector<HostAndP
         });
 
     auto hedgeOptions = extractHedgeOptions(_cmdObj, _ars->_readPreference);
+    auto firstHost = hostAndPorts.front();
     executor::RemoteCommandRequestOnAny request(std::move(hostAndPorts),
                                                 _ars->_db,
                                                 _cmdObj,
@@ -223,14 +233,41 @@ auto AsyncRequestsSender::RemoteData::scheduleRemoteCommand(std::vector<HostAndP
     // future returning variant of scheduleRemoteCommand
     auto [p, f] = makePromiseFuture<RemoteCommandOnAnyCallbackArgs>();
 
+    // The executor runs the callback exactly once even if the request is canceled, unlike the
+    // continuations on the sub-baton, which are skipped once the ARS is interrupted. So the
+    // callback is what releases the request from the ReplicaLatencyTracker. It must not refer to
+    // this RemoteData, which may be gone by the time a canceled request completes.
+    ReplicaLatencyTracker* latencyTracker = nullptr;
+    if (gReadAdaptiveReplicaSelection.load()) {
+        latencyTracker = ReplicaLatencyTracker::get(_ars->_opCtx->getServiceContext());
+        latencyTracker->onRequestStarted(firstHost);
+    }
+    auto releaseTrackerOnScheduleFailure = makeGuard([&] {
+        if (latencyTracker) {
+            latencyTracker->onRequestFinished(firstHost, boost::none, boost::none, Date_t::now());
+        }
+    });
+
     // Failures to schedule skip the retry loop
     uassertStatusOK(_ars->_subExecutor->scheduleRemoteCommandOnAny(
         request,
         // We have to make a shared_ptr<Promise> here because scheduleRemoteCommand requires
         // copyable callbacks
-        [p = std::make_shared<Promise<RemoteCommandOnAnyCallbackArgs>>(std::move(p))](
-            const RemoteCommandOnAnyCallbackArgs& cbData) { p->emplaceValue(cbData); },
+        [p = std::make_shared<Promise<RemoteCommandOnAnyCallbackArgs>>(std::move(p)),
+         latencyTracker,
+         firstHost](const RemoteCommandOnAnyCallbackArgs& cbData) {
+            if (latencyTracker) {
+                const auto& response = cbData.response;
+                latencyTracker->onRequestFinished(firstHost,
+                                                  response.status.isOK() ? response.target
+                                                                         : boost::none,
+                                                  response.elapsed,
+                                                  Date_t::now());
+            }
+            p->emplaceValue(cbData);
+        },
         *_ars->_subBaton));
+    releaseTrackerOnScheduleFailure.dismiss();
 
     return std::move(f).semi();
 }
@@ -41,7 +41,6 @@ namespace mongo {
 
 ChunkInfo::ChunkInfo(const ChunkType& from)
     : _range(from.getMin(), from.getMax()),
-      _maxKeyString(ShardKeyPattern::toKeyString(from.getMax())),
       _shardId(from.getShard()),
       _lastmod(from.getVersion()),
       _history(from.getHistory()),
@@ -51,14 +50,12 @@ ChunkInfo::ChunkInfo(const ChunkType& from)
 }
 
 ChunkInfo::ChunkInfo(ChunkRange range,
-                     std::string maxKeyString,
                      ShardId shardId,
                      ChunkVersion version,
                      std::vector<ChunkHistory> history,
                      bool jumbo,
                      std::shared_ptr<ChunkWritesTracker> writesTracker)
     : _range(std::move(range)),
-      _maxKeyString(std::move(maxKeyString)),
       _shardId(shardId),
       _lastmod(std::move(version)),
       _history(std::move(history)),
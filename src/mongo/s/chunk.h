@@ -46,7 +46,6 @@ public:
     explicit ChunkInfo(const ChunkType& from);
 
     ChunkInfo(ChunkRange range,
-              std::string maxKeyString,
               ShardId shardId,
               ChunkVersion version,
               std::vector<ChunkHistory> history,
@@ -65,10 +64,6 @@ public:
         return _range.getMax();
     }
 
-    const std::string& getMaxKeyString() const {
-        return _maxKeyString;
-    }
-
     const ShardId& getShardId() const {
         return _shardId;
     }
@@ -120,7 +115,6 @@ public:
 
 private:
     const ChunkRange _range;
-    const std::string _maxKeyString;
 
     const ShardId _shardId;
 
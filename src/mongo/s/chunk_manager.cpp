@@ -45,6 +45,7 @@
 #include "mongo/s/chunk_writes_tracker.h"
 #include "mongo/s/mongod_and_mongos_server_parameters_gen.h"
 #include "mongo/s/shard_invalidated_for_targeting_exception.h"
+#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 namespace {
@@ -64,15 +65,14 @@ void checkAllElementsAreOfType(BSONType type, const BSONObj& o) {
             allElementsAreOfType(type, o));
 }
 
-void appendChunkTo(std::vector<std::shared_ptr<ChunkInfo>>& chunks,
-                   const std::shared_ptr<ChunkInfo>& chunk) {
-    if (!chunks.empty() && chunk->getRange().overlaps(chunks.back()->getRange())) {
-        if (chunks.back()->getLastmod().isOlderThan(chunk->getLastmod())) {
-            chunks.pop_back();
-            chunks.push_back(chunk);
+void appendChunkTo(std::vector<ChunkMap::ChunkInfoAndMaxKeyString>& chunks,
+                   ChunkMap::ChunkInfoAndMaxKeyString chunk) {
+    if (!chunks.empty() && chunk.first->getRange().overlaps(chunks.back().first->getRange())) {
+        if (chunks.back().first->getLastmod().isOlderThan(chunk.first->getLastmod())) {
+            chunks.back() = std::move(chunk);
         }
     } else {
-        chunks.push_back(chunk);
+        chunks.push_back(std::move(chunk));
     }
 }
 
@@ -84,26 +84,30 @@ void appendChunkTo(std::vector<std::shared_ptr<ChunkInfo>>& chunks,
 // precomputed KeyString representations of the maximum bounds, this function implements the same
 // algorithm by reverse sorting the chunks by the maximum before processing but then must
 // reverse the resulting collection before it is returned.
-std::vector<std::shared_ptr<ChunkInfo>> flatten(const std::vector<ChunkType>& changedChunks) {
+std::vector<ChunkMap::ChunkInfoAndMaxKeyString> flatten(
+    const std::vector<ChunkType>& changedChunks) {
     if (changedChunks.empty())
-        return std::vector<std::shared_ptr<ChunkInfo>>();
+        return std::vector<ChunkMap::ChunkInfoAndMaxKeyString>();
 
-    std::vector<std::shared_ptr<ChunkInfo>> changedChunkInfos(changedChunks.size());
+    std::vector<ChunkMap::ChunkInfoAndMaxKeyString> changedChunkInfos(changedChunks.size());
     std::transform(changedChunks.begin(),
                    changedChunks.end(),
                    changedChunkInfos.begin(),
-                   [](const auto& c) { return std::make_shared<ChunkInfo>(c); });
+                   [](const auto& c) -> ChunkMap::ChunkInfoAndMaxKeyString {
+                       return {std::make_shared<ChunkInfo>(c),
+                               ShardKeyPattern::toKeyString(c.getMax())};
+                   });
 
     std::sort(changedChunkInfos.begin(), changedChunkInfos.end(), [](const auto& a, const auto& b) {
-        return a->getMaxKeyString() > b->getMaxKeyString();
+        return a.second > b.second;
     });
 
-    std::vector<std::shared_ptr<ChunkInfo>> flattened;
+    std::vector<ChunkMap::ChunkInfoAndMaxKeyString> flattened;
     flattened.reserve(changedChunkInfos.size());
-    flattened.push_back(changedChunkInfos[0]);
+    flattened.push_back(std::move(changedChunkInfos[0]));
 
     for (size_t i = 1; i < changedChunkInfos.size(); ++i) {
-        appendChunkTo(flattened, changedChunkInfos[i]);
+        appendChunkTo(flattened, std::move(changedChunkInfos[i]));
     }
 
     std::reverse(flattened.begin(), flattened.end());
@@ -115,43 +119,16 @@ std::vector<std::shared_ptr<ChunkInfo>> flatten(const std::vector<ChunkType>& ch
 
 ShardVersionMap ChunkMap::constructShardVersionMap() const {
     ShardVersionMap shardVersions;
-    ChunkVector::const_iterator current = _chunkMap.cbegin();
 
     boost::optional<BSONObj> firstMin = boost::none;
     boost::optional<BSONObj> lastMax = boost::none;
 
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = *current;
-        const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
-
-        // Tracks the max shard version for the shard on which the current range will reside
-        auto shardVersionIt = shardVersions.find(currentRangeShardId);
-        if (shardVersionIt == shardVersions.end()) {
-            shardVersionIt = shardVersions
-                                 .emplace(std::piecewise_construct,
-                                          std::forward_as_tuple(currentRangeShardId),
-                                          std::forward_as_tuple(_collectionVersion.epoch(),
-                                                                _collectionVersion.getTimestamp()))
-                                 .first;
-        }
-
-        auto& maxShardVersion = shardVersionIt->second.shardVersion;
-
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId, &maxShardVersion](const auto& currentChunk) {
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
-
-                             if (maxShardVersion.isOlderThan(currentChunk->getLastmod()))
-                                 maxShardVersion = currentChunk->getLastmod();
-
-                             return false;
-                         });
-
-        const auto rangeLast = *std::prev(current);
+    // The current range is the run of consecutive chunks which reside on the same shard.
+    std::shared_ptr<ChunkInfo> firstChunkInRange;
+    std::shared_ptr<ChunkInfo> rangeLast;
+    ChunkVersion* maxShardVersion = nullptr;
 
+    auto finishRange = [&] {
         const auto& rangeMin = firstChunkInRange->getMin();
         const auto& rangeMax = rangeLast->getMax();
 
@@ -176,10 +153,43 @@ ShardVersionMap ChunkMap::constructShardVersionMap() const {
 
         // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
         // somewhere, which should have been caught at chunk load time
-        invariant(maxShardVersion.isSet());
+        invariant(maxShardVersion->isSet());
+    };
+
+    forEach([&](const std::shared_ptr<ChunkInfo>& chunk) {
+        const auto& shardId = chunk->getShardIdAt(boost::none);
+        if (!firstChunkInRange || firstChunkInRange->getShardIdAt(boost::none) != shardId) {
+            if (firstChunkInRange) {
+                finishRange();
+            }
+            firstChunkInRange = chunk;
+
+            // Tracks the max shard version for the shard on which the current range will reside
+            auto shardVersionIt = shardVersions.find(shardId);
+            if (shardVersionIt == shardVersions.end()) {
+                shardVersionIt =
+                    shardVersions
+                        .emplace(std::piecewise_construct,
+                                 std::forward_as_tuple(shardId),
+                                 std::forward_as_tuple(_collectionVersion.epoch(),
+                                                       _collectionVersion.getTimestamp()))
+                        .first;
+            }
+            maxShardVersion = &shardVersionIt->second.shardVersion;
+        }
+
+        if (maxShardVersion->isOlderThan(chunk->getLastmod()))
+            *maxShardVersion = chunk->getLastmod();
+
+        rangeLast = chunk;
+        return true;
+    });
+
+    if (firstChunkInRange) {
+        finishRange();
     }
 
-    if (!_chunkMap.empty()) {
+    if (_size > 0) {
         invariant(!shardVersions.empty());
         invariant(firstMin.is_initialized());
         invariant(lastMax.is_initialized());
@@ -191,9 +201,75 @@ ShardVersionMap ChunkMap::constructShardVersionMap() const {
     return shardVersions;
 }
 
+void ChunkMap::ChunkBlock::append(const std::shared_ptr<ChunkInfo>& chunk,
+                                  StringData maxKeyString) {
+    if (chunks.empty() || maxVersion.isOlderThan(chunk->getLastmod())) {
+        maxVersion = chunk->getLastmod();
+    }
+    chunks.push_back(chunk);
+    maxKeyStrings.append(maxKeyString.rawData(), maxKeyString.size());
+    maxKeyStringEnds.push_back(maxKeyStrings.size());
+}
+
+void ChunkMap::ChunkBlock::popBack() {
+    // The max version is left as is: callers only pop a chunk to replace it with a newer one.
+    chunks.pop_back();
+    maxKeyStringEnds.pop_back();
+    maxKeyStrings.resize(maxKeyStringEnds.empty() ? 0 : maxKeyStringEnds.back());
+}
+
 void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
-    const auto chunkVersion = chunk->getLastmod();
+    _appendChunk(chunk, ShardKeyPattern::toKeyString(chunk->getMax()));
+}
+
+void ChunkMap::_appendChunk(const std::shared_ptr<ChunkInfo>& chunk, StringData maxKeyString) {
+    if (_size > 0 && chunk->getRange().overlaps(_lastChunk()->getRange())) {
+        if (_lastChunk()->getLastmod().isOlderThan(chunk->getLastmod())) {
+            auto& block = _mutableLastBlock();
+            block.popBack();
+            block.append(chunk, maxKeyString);
+        }
+    } else {
+        // Start a new block when the last one is full. If it is shared with another map, copying
+        // it is only worth it while it is small; otherwise leave it as is and start a new block.
+        if (_blocks.empty() || _blocks.back()->size() >= kMaxChunksPerBlock ||
+            (_blocks.back().use_count() > 1 &&
+             _blocks.back()->size() >= kMaxChunksPerBlock / 2)) {
+            _blocks.push_back(std::make_shared<ChunkBlock>());
+        }
+        _mutableLastBlock().append(chunk, maxKeyString);
+        ++_size;
+    }
+
+    _updateCollectionVersion(chunk->getLastmod());
+}
+
+void ChunkMap::_appendBlock(const std::shared_ptr<ChunkBlock>& block) {
+    // Fold small blocks into the one being built to keep the number of blocks from growing with
+    // every refresh.
+    if (!_blocks.empty() && _blocks.back().use_count() == 1 &&
+        _blocks.back()->size() + block->size() <= kMaxChunksPerBlock) {
+        auto& lastBlock = *_blocks.back();
+        for (size_t i = 0; i < block->size(); ++i) {
+            lastBlock.append(block->chunks[i], block->getMaxKeyString(i));
+        }
+    } else {
+        _blocks.push_back(block);
+    }
+    _size += block->size();
+
+    _updateCollectionVersion(block->maxVersion);
+}
+
+ChunkMap::ChunkBlock& ChunkMap::_mutableLastBlock() {
+    auto& lastBlock = _blocks.back();
+    if (lastBlock.use_count() > 1) {
+        lastBlock = std::make_shared<ChunkBlock>(*lastBlock);
+    }
+    return *lastBlock;
+}
+
+void ChunkMap::_updateCollectionVersion(const ChunkVersion& chunkVersion) {
     if (_collectionVersion.isOlderThan(chunkVersion)) {
         _collectionVersion = ChunkVersion(chunkVersion.majorVersion(),
                                           chunkVersion.minorVersion(),
@@ -203,10 +279,10 @@ void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
 }
 
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
-    const auto it = _findIntersectingChunk(shardKey);
+    const auto pos = _findIntersectingChunk(shardKey);
 
-    if (it != _chunkMap.end())
-        return *it;
+    if (pos.block < _blocks.size())
+        return _blocks[pos.block]->chunks[pos.chunk];
 
     return std::shared_ptr<ChunkInfo>();
 }
@@ -222,90 +298,170 @@ void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion&
 
 ChunkMap ChunkMap::createMerged(
     const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const {
-    size_t chunkMapIndex = 0;
-    size_t changedChunkIndex = 0;
+    std::vector<ChunkInfoAndMaxKeyString> changedChunksAndMaxKeyStrings;
+    changedChunksAndMaxKeyStrings.reserve(changedChunks.size());
+    for (const auto& chunk : changedChunks) {
+        changedChunksAndMaxKeyStrings.emplace_back(chunk,
+                                                   ShardKeyPattern::toKeyString(chunk->getMax()));
+    }
+    return createMerged(changedChunksAndMaxKeyStrings);
+}
 
-    ChunkMap updatedChunkMap(
-        getVersion().epoch(), getVersion().getTimestamp(), _chunkMap.size() + changedChunks.size());
+ChunkMap ChunkMap::createMerged(const std::vector<ChunkInfoAndMaxKeyString>& changedChunks) const {
+    size_t changedChunkIndex = 0;
 
-    while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
-        if (chunkMapIndex >= _chunkMap.size()) {
-            validateChunk(changedChunks[changedChunkIndex], getVersion());
-            updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
+    ChunkMap updatedChunkMap(getVersion().epoch(), getVersion().getTimestamp());
+    updatedChunkMap._blocks.reserve(_blocks.size() + changedChunks.size() / kMaxChunksPerBlock +
+                                    1);
+
+    auto appendChangedChunk = [&] {
+        const auto& changedChunk = changedChunks[changedChunkIndex++];
+        validateChunk(changedChunk.first, getVersion());
+        updatedChunkMap._appendChunk(changedChunk.first, changedChunk.second);
+    };
+
+    for (const auto& block : _blocks) {
+        // A block can be carried over unchanged if merging it chunk by chunk would append all of
+        // its chunks as they are: none of them overlaps the next changed chunk nor the last chunk
+        // appended so far.
+        const auto& blockMin = block->chunks.front()->getMin();
+        const auto& blockMax = block->chunks.back()->getMax();
+        const bool overlapsChangedChunk = changedChunkIndex < changedChunks.size() &&
+            ChunkRange(blockMin, blockMax)
+                .overlaps(changedChunks[changedChunkIndex].first->getRange());
+        const bool overlapsLastChunk = updatedChunkMap._size > 0 &&
+            updatedChunkMap._lastChunk()->getRange().overlaps(ChunkRange(blockMin, blockMax));
+        if (!overlapsChangedChunk && !overlapsLastChunk) {
+            updatedChunkMap._appendBlock(block);
             continue;
         }
 
-        if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
-            continue;
-        }
+        size_t chunkIndex = 0;
+        while (chunkIndex < block->size()) {
+            if (changedChunkIndex >= changedChunks.size()) {
+                updatedChunkMap._appendChunk(block->chunks[chunkIndex],
+                                             block->getMaxKeyString(chunkIndex));
+                ++chunkIndex;
+                continue;
+            }
 
-        auto overlap = _chunkMap[chunkMapIndex]->getRange().overlaps(
-            changedChunks[changedChunkIndex]->getRange());
+            auto overlap = block->chunks[chunkIndex]->getRange().overlaps(
+                changedChunks[changedChunkIndex].first->getRange());
 
-        if (overlap) {
-            auto& changedChunk = changedChunks[changedChunkIndex++];
-            auto& chunkInfo = _chunkMap[chunkMapIndex];
+            if (overlap) {
+                const auto& changedChunk = changedChunks[changedChunkIndex];
+                const auto& chunkInfo = block->chunks[chunkIndex];
 
-            auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
-            changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
+                auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
+                changedChunk.first->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
 
-            validateChunk(changedChunk, getVersion());
-            updatedChunkMap.appendChunk(changedChunk);
-        } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+                appendChangedChunk();
+            } else {
+                updatedChunkMap._appendChunk(block->chunks[chunkIndex],
+                                             block->getMaxKeyString(chunkIndex));
+                ++chunkIndex;
+            }
         }
     }
 
+    while (changedChunkIndex < changedChunks.size()) {
+        appendChangedChunk();
+    }
+
     return updatedChunkMap;
 }
 
+size_t ChunkMap::getMaxKeyStringsBytes() const {
+    size_t bytes = 0;
+    for (const auto& block : _blocks) {
+        bytes += block->maxKeyStrings.size() + block->maxKeyStringEnds.size() * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+size_t ChunkMap::numBlocksSharedWith(const ChunkMap& other) const {
+    stdx::unordered_set<const ChunkBlock*> otherBlocks;
+    for (const auto& block : other._blocks) {
+        otherBlocks.insert(block.get());
+    }
+    return std::count_if(_blocks.begin(), _blocks.end(), [&](const auto& block) {
+        return otherBlocks.count(block.get()) > 0;
+    });
+}
+
 BSONObj ChunkMap::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("startingVersion"_sd, getVersion().toBSON());
-    builder.append("chunkCount", static_cast<int64_t>(_chunkMap.size()));
+    builder.append("chunkCount", static_cast<int64_t>(_size));
 
     {
         BSONArrayBuilder arrayBuilder(builder.subarrayStart("chunks"_sd));
-        for (const auto& chunk : _chunkMap) {
+        forEach([&](const std::shared_ptr<ChunkInfo>& chunk) {
             arrayBuilder.append(chunk->toString());
-        }
+            return true;
+        });
     }
 
     return builder.obj();
 }
 
-ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
-                                                                       bool isMaxInclusive) const {
-    auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
+ChunkMap::ChunkPosition ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
+                                                         bool isMaxInclusive) const {
+    const auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
+    const StringData key(shardKeyString);
+
+    // Finds the first position in [0, count) for which 'getMaxKeyString' is greater than (or, if
+    // 'isMaxInclusive' is false, greater than or equal to) the shard key. This is equivalent to
+    // std::upper_bound (respectively std::lower_bound) over the max keys, but only touches the
+    // contiguous KeyString buffers rather than the ChunkInfo objects.
+    auto partitionPoint = [&](size_t count, auto getMaxKeyString) {
+        size_t first = 0;
+        while (count > 0) {
+            const size_t step = count / 2;
+            const size_t mid = first + step;
+            const int cmp = getMaxKeyString(mid).compare(key);
+            if (cmp < 0 || (isMaxInclusive && cmp == 0)) {
+                first = mid + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        return first;
+    };
 
-    if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
-    } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
+    const size_t block = partitionPoint(_blocks.size(), [this](size_t i) {
+        const auto& block = *_blocks[i];
+        return block.getMaxKeyString(block.size() - 1);
+    });
+    if (block == _blocks.size()) {
+        return _end();
     }
+
+    const auto& chunkBlock = *_blocks[block];
+    const size_t chunk = partitionPoint(
+        chunkBlock.size(), [&chunkBlock](size_t i) { return chunkBlock.getMaxKeyString(i); });
+    invariant(chunk < chunkBlock.size());
+
+    return {block, chunk};
 }
 
-std::pair<ChunkMap::ChunkVector::const_iterator, ChunkMap::ChunkVector::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
-    const auto itMin = _findIntersectingChunk(min);
-    const auto itMax = [&]() {
-        auto it = _findIntersectingChunk(max, isMaxInclusive);
-        return it == _chunkMap.end() ? it : ++it;
+std::pair<ChunkMap::ChunkPosition, ChunkMap::ChunkPosition> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+    const auto posMin = _findIntersectingChunk(min);
+    const auto posMax = [&]() {
+        auto pos = _findIntersectingChunk(max, isMaxInclusive);
+        if (pos.block == _blocks.size()) {
+            return pos;
+        }
+        if (++pos.chunk == _blocks[pos.block]->size()) {
+            pos = {pos.block + 1, 0};
+        }
+        return pos;
     }();
 
-    return {itMin, itMax};
+    return {posMin, posMax};
 }
 
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch,
@@ -821,11 +977,10 @@ RoutingTableHistory RoutingTableHistory::makeUpdatedReplacingTimestamp(
     const boost::optional<Timestamp>& timestamp) const {
     invariant(getVersion().getTimestamp().is_initialized() != timestamp.is_initialized());
 
-    ChunkMap newMap(getVersion().epoch(), timestamp, _chunkMap.size());
+    ChunkMap newMap(getVersion().epoch(), timestamp);
     _chunkMap.forEach([&](const std::shared_ptr<ChunkInfo>& chunkInfo) {
         const ChunkVersion oldVersion = chunkInfo->getLastmod();
         newMap.appendChunk(std::make_shared<ChunkInfo>(chunkInfo->getRange(),
-                                                       chunkInfo->getMaxKeyString(),
                                                        chunkInfo->getShardId(),
                                                        ChunkVersion(oldVersion.majorVersion(),
                                                                     oldVersion.minorVersion(),
@@ -73,19 +73,59 @@ using ShardVersionMap = stdx::unordered_map<ShardId, ShardVersionTargetingInfo,
  * underlying implementation.
  */
 class ChunkMap {
-    // Vector of chunks ordered by max key.
-    using ChunkVector = std::vector<std::shared_ptr<ChunkInfo>>;
+    // Chunks are kept ordered by max key and split into blocks of consecutive chunks. A block is
+    // never modified once it is shared between ChunkMaps, so a ChunkMap produced by createMerged()
+    // shares every block that the merged changes did not touch with the map it was created from.
+    // This keeps a refresh which only changes a few chunks proportional to the number of blocks
+    // and the size of the touched blocks, rather than to the number of chunks.
+    struct ChunkBlock {
+        size_t size() const {
+            return chunks.size();
+        }
+
+        /**
+         * Returns the KeyString encoding of the max key of the chunk at position 'i'.
+         */
+        StringData getMaxKeyString(size_t i) const {
+            const size_t begin = i == 0 ? 0 : maxKeyStringEnds[i - 1];
+            return StringData(maxKeyStrings.data() + begin, maxKeyStringEnds[i] - begin);
+        }
+
+        void append(const std::shared_ptr<ChunkInfo>& chunk, StringData maxKeyString);
+        void popBack();
+
+        std::vector<std::shared_ptr<ChunkInfo>> chunks;
+
+        // The KeyString encodings of the max keys of 'chunks', laid out back to back in the same
+        // order, so that lookups binary search over a contiguous buffer rather than chasing a
+        // pointer for every probe. The encoding for the chunk at position 'i' ends at offset
+        // 'maxKeyStringEnds[i]'.
+        std::string maxKeyStrings;
+        std::vector<uint32_t> maxKeyStringEnds;
+
+        // Max version across the chunks of this block.
+        ChunkVersion maxVersion;
+    };
+
+    // Position of a chunk in the map: the index of its block and its index within that block. The
+    // end position is {_blocks.size(), 0}.
+    struct ChunkPosition {
+        size_t block;
+        size_t chunk;
+    };
 
 public:
-    explicit ChunkMap(OID epoch,
-                      const boost::optional<Timestamp>& timestamp,
-                      size_t initialCapacity = 0)
-        : _collectionVersion(0, 0, epoch, timestamp), _collTimestamp(timestamp) {
-        _chunkMap.reserve(initialCapacity);
-    }
+    // A chunk along with the KeyString encoding of its max key.
+    using ChunkInfoAndMaxKeyString = std::pair<std::shared_ptr<ChunkInfo>, std::string>;
+
+    // Maximum number of chunks a block may hold.
+    static constexpr size_t kMaxChunksPerBlock = 1024;
+
+    explicit ChunkMap(OID epoch, const boost::optional<Timestamp>& timestamp)
+        : _collectionVersion(0, 0, epoch, timestamp), _collTimestamp(timestamp) {}
 
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
     }
 
     ChunkVersion getVersion() const {
@@ -94,12 +134,9 @@ public:
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
-
-        for (; it != _chunkMap.end(); ++it) {
-            if (!handler(*it))
-                break;
-        }
+        const auto first =
+            shardKey.isEmpty() ? ChunkPosition{0, 0} : _findIntersectingChunk(shardKey);
+        _forEachInRange(first, _end(), std::forward<Callable>(handler));
     }
 
     template <typename Callable>
@@ -108,29 +145,90 @@ public:
                                  bool isMaxInclusive,
                                  Callable&& handler) const {
         const auto bounds = _overlappingBounds(min, max, isMaxInclusive);
-
-        for (auto it = bounds.first; it != bounds.second; ++it) {
-            if (!handler(*it))
-                break;
-        }
+        _forEachInRange(bounds.first, bounds.second, std::forward<Callable>(handler));
     }
 
     ShardVersionMap constructShardVersionMap() const;
     std::shared_ptr<ChunkInfo> findIntersectingChunk(const BSONObj& shardKey) const;
 
+    /**
+     * Appends 'chunk' after all the chunks in this map. Must only be used while building a new map.
+     */
     void appendChunk(const std::shared_ptr<ChunkInfo>& chunk);
 
     ChunkMap createMerged(const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const;
 
+    /**
+     * Same as above, but takes the changed chunks with their max keys already encoded as KeyString,
+     * which avoids re-encoding them.
+     */
+    ChunkMap createMerged(const std::vector<ChunkInfoAndMaxKeyString>& changedChunks) const;
+
+    /**
+     * Returns the number of bytes used by the KeyString encodings of the chunks' max keys.
+     */
+    size_t getMaxKeyStringsBytes() const;
+
+    /**
+     * Returns the number of blocks the chunks are split into.
+     */
+    size_t numBlocks() const {
+        return _blocks.size();
+    }
+
+    /**
+     * Returns the number of blocks this map shares with 'other'.
+     */
+    size_t numBlocksSharedWith(const ChunkMap& other) const;
+
     BSONObj toBSON() const;
 
 private:
-    ChunkVector::const_iterator _findIntersectingChunk(const BSONObj& shardKey,
-                                                       bool isMaxInclusive = true) const;
-    std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    ChunkPosition _end() const {
+        return {_blocks.size(), 0};
+    }
+
+    template <typename Callable>
+    void _forEachInRange(ChunkPosition first, ChunkPosition last, Callable&& handler) const {
+        for (size_t b = first.block; b < _blocks.size() && b <= last.block; ++b) {
+            const auto& chunks = _blocks[b]->chunks;
+            const size_t begin = b == first.block ? first.chunk : 0;
+            const size_t end = b == last.block ? last.chunk : chunks.size();
+            for (size_t i = begin; i < end; ++i) {
+                if (!handler(chunks[i]))
+                    return;
+            }
+        }
+    }
+
+    const std::shared_ptr<ChunkInfo>& _lastChunk() const {
+        return _blocks.back()->chunks.back();
+    }
 
-    ChunkVector _chunkMap;
+    void _appendChunk(const std::shared_ptr<ChunkInfo>& chunk, StringData maxKeyString);
+
+    /**
+     * Appends all the chunks of 'block', sharing it with the map it comes from when possible.
+     * Requires that none of its chunks overlaps the last chunk of this map.
+     */
+    void _appendBlock(const std::shared_ptr<ChunkBlock>& block);
+
+    /**
+     * Returns the last block, copying it first if it is shared with another map.
+     */
+    ChunkBlock& _mutableLastBlock();
+
+    void _updateCollectionVersion(const ChunkVersion& chunkVersion);
+
+    ChunkPosition _findIntersectingChunk(const BSONObj& shardKey, bool isMaxInclusive = true) const;
+    std::pair<ChunkPosition, ChunkPosition> _overlappingBounds(const BSONObj& min,
+                                                               const BSONObj& max,
+                                                               bool isMaxInclusive) const;
+
+    std::vector<std::shared_ptr<ChunkBlock>> _blocks;
+
+    // Total number of chunks across all blocks.
+    size_t _size{0};
 
     // Max version across all chunks
     ChunkVersion _collectionVersion;
@@ -258,6 +356,10 @@ public:
         return _chunkMap.size();
     }
 
+    size_t getMaxKeyStringsBytes() const {
+        return _chunkMap.getMaxKeyStringsBytes();
+    }
+
     template <typename Callable>
     void forEachChunk(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
         _chunkMap.forEach(std::forward<Callable>(handler), shardKey);
@@ -36,6 +36,7 @@
 #include "mongo/platform/random.h"
 #include "mongo/s/chunk_manager.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -191,6 +192,28 @@ auto BM_FullBuildOfChunkManager(benchmark::State& state, ShardSelectorFn selectS
     }
 }
 
+/**
+ * Builds a routing table with one million chunks and reports how much the process' resident
+ * memory grew while it was alive, along with the portion taken by the chunks' max keys.
+ */
+template <typename ShardSelectorFn>
+void BM_MemoryFootprintOfChunkManager(benchmark::State& state, ShardSelectorFn selectShard) {
+    const int nShards = state.range(0);
+    const uint32_t nChunks = state.range(1);
+
+    for (auto keepRunning : state) {
+        const auto residentMBBefore = ProcessInfo().getResidentSize();
+
+        auto metadata = makeChunkManagerWithShardSelector(nShards, nChunks, selectShard);
+
+        const auto residentMBAfter = ProcessInfo().getResidentSize();
+        state.counters["residentMB"] = residentMBAfter - residentMBBefore;
+        state.counters["maxKeyStringsBytes"] =
+            metadata.getChunkManager()->getRoutingTableHistory_ForTest().getMaxKeyStringsBytes();
+        benchmark::DoNotOptimize(metadata);
+    }
+}
+
 std::vector<BSONObj> makeKeys(int nChunks) {
     constexpr int nFinds = 200000;
     static_assert(nFinds % 2 == 0, "");
@@ -415,6 +438,16 @@ MONGO_INITIALIZER(RegisterBenchmarks)(InitializerContext* context) {
             ->Args({1000, 50000})
             ->Args({2, 2});
     }
+
+    std::initializer_list<benchmark::internal::Benchmark*> memoryBmCases{
+        REGISTER_BENCHMARK_CAPTURE(
+            BM_MemoryFootprintOfChunkManager, Pessimal, pessimalShardSelector),
+        REGISTER_BENCHMARK_CAPTURE(BM_MemoryFootprintOfChunkManager, Optimal, optimalShardSelector),
+    };
+
+    for (auto bmCase : memoryBmCases) {
+        bmCase->Args({100, 1000000})->Iterations(1)->Unit(benchmark::kMillisecond);
+    }
 }
 
 }  // namespace
@@ -34,6 +34,7 @@
 #include "mongo/s/chunk_manager_targeter.h"
 
 #include "mongo/base/counter.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -317,33 +318,96 @@ BSONObj ChunkManagerTargeter::extractBucketsShardKeyFromTimeseriesDoc(
 
 ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
                                                  const BSONObj& doc) const {
-    BSONObj shardKey;
-
+    // Target the shard key or database primary
     if (_cm->isSharded()) {
-        const auto& shardKeyPattern = _cm->getShardKeyPattern();
-        if (_nss.isTimeseriesBucketsCollection()) {
-            auto tsFields = _cm->getTimeseriesFields();
-            tassert(5743701, "Missing timeseriesFields on buckets collection", tsFields);
-            shardKey = extractBucketsShardKeyFromTimeseriesDoc(
-                doc, shardKeyPattern, tsFields->getTimeseriesOptions());
-        } else {
-            shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
+        return uassertStatusOK(
+            _targetShardKey(_extractInsertShardKey(doc), CollationSpec::kSimpleSpec));
+    }
+
+    return _targetDbPrimary();
+}
+
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    if (!_cm->isSharded()) {
+        return std::vector<StatusWith<ShardEndpoint>>(docs.size(), _targetDbPrimary());
+    }
+
+    std::vector<Status> statuses(docs.size(), Status::OK());
+    std::vector<BSONObj> shardKeys(docs.size());
+    std::vector<size_t> order;
+    order.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        try {
+            shardKeys[i] = _extractInsertShardKey(docs[i]);
+            order.push_back(i);
+        } catch (const DBException& ex) {
+            statuses[i] = ex.toStatus();
         }
+    }
 
-        // The shard key would only be empty after extraction if we encountered an error case, such
-        // as the shard key possessing an array value or array descendants. If the shard key
-        // presented to the targeter was empty, we would emplace the missing fields, and the
-        // extracted key here would *not* be empty.
-        uassert(ErrorCodes::ShardKeyNotFound,
-                "Shard key cannot contain array values or array descendants.",
-                !shardKey.isEmpty());
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return SimpleBSONObjComparator::kInstance.evaluate(shardKeys[lhs] < shardKeys[rhs]);
+    });
+
+    // Walk the shard keys in ascending order, only looking up a new chunk once a key falls past
+    // the range of the chunk that owns the previous one.
+    std::vector<boost::optional<ShardEndpoint>> targeted(docs.size());
+    boost::optional<Chunk> chunk;
+    boost::optional<ShardEndpoint> chunkEndpoint;
+    for (const auto i : order) {
+        if (!chunk || !chunk->containsKey(shardKeys[i])) {
+            chunk = boost::none;
+            try {
+                chunk.emplace(_cm->findIntersectingChunk(shardKeys[i], CollationSpec::kSimpleSpec));
+                chunkEndpoint.emplace(
+                    chunk->getShardId(), _cm->getVersion(chunk->getShardId()), boost::none);
+            } catch (const DBException& ex) {
+                chunk = boost::none;
+                statuses[i] = ex.toStatus();
+                continue;
+            }
+        }
+        targeted[i] = *chunkEndpoint;
     }
 
-    // Target the shard key or database primary
-    if (!shardKey.isEmpty()) {
-        return uassertStatusOK(_targetShardKey(shardKey, CollationSpec::kSimpleSpec));
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (statuses[i].isOK()) {
+            endpoints.emplace_back(std::move(*targeted[i]));
+        } else {
+            endpoints.emplace_back(std::move(statuses[i]));
+        }
     }
+    return endpoints;
+}
+
+BSONObj ChunkManagerTargeter::_extractInsertShardKey(const BSONObj& doc) const {
+    BSONObj shardKey;
+
+    const auto& shardKeyPattern = _cm->getShardKeyPattern();
+    if (_nss.isTimeseriesBucketsCollection()) {
+        auto tsFields = _cm->getTimeseriesFields();
+        tassert(5743701, "Missing timeseriesFields on buckets collection", tsFields);
+        shardKey = extractBucketsShardKeyFromTimeseriesDoc(
+            doc, shardKeyPattern, tsFields->getTimeseriesOptions());
+    } else {
+        shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
+    }
+
+    // The shard key would only be empty after extraction if we encountered an error case, such as
+    // the shard key possessing an array value or array descendants. If the shard key presented to
+    // the targeter was empty, we would emplace the missing fields, and the extracted key here would
+    // *not* be empty.
+    uassert(ErrorCodes::ShardKeyNotFound,
+            "Shard key cannot contain array values or array descendants.",
+            !shardKey.isEmpty());
+
+    return shardKey;
+}
 
+ShardEndpoint ChunkManagerTargeter::_targetDbPrimary() const {
     // TODO (SERVER-51070): Remove the boost::none when the config server can support shardVersion
     // in commands
     return ShardEndpoint(
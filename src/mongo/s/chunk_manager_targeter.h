@@ -79,6 +79,13 @@ public:
 
     ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const override;
 
+    /**
+     * Extracts the shard keys of all of 'docs' in one pass and visits them in shard key order, so
+     * that runs of documents falling into the same chunk are targeted with a single chunk lookup.
+     */
+    std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const override;
+
     std::vector<ShardEndpoint> targetUpdate(OperationContext* opCtx,
                                             const BatchItemRef& itemRef) const override;
 
@@ -130,6 +137,17 @@ private:
         const BSONObj& query,
         const BSONObj& collation) const;
 
+    /**
+     * Returns the shard key of an insert document for a sharded collection. Throws
+     * ShardKeyNotFound if the document has array values along the shard key paths.
+     */
+    BSONObj _extractInsertShardKey(const BSONObj& doc) const;
+
+    /**
+     * Returns the ShardEndpoint of the database primary, which owns all unsharded collections.
+     */
+    ShardEndpoint _targetDbPrimary() const;
+
     /**
      * Returns a ShardEndpoint for an exact shard key query.
      *
@@ -188,6 +188,45 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertsWithConstantHashedPrefixAndVarying
     ASSERT_EQUALS(res.shardName, "1");
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsMatchesTargetingEachInsert) {
+    // Create 5 chunks and 5 shards such that shardId '0' has chunk [MinKey, null), '1' has chunk
+    // [null, -100), '2' has chunk [-100, 0), '3' has chunk ['0', 100) and '4' has chunk
+    // [100, MaxKey).
+    std::vector<BSONObj> splitPoints = {
+        BSON("a" << BSONNULL), BSON("a" << -100), BSON("a" << 0), BSON("a" << 100)};
+    auto cmTargeter = prepare(BSON("a" << 1), splitPoints);
+
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 500; i++) {
+        docs.push_back(BSON("a" << ((i * 37) % 500) - 250));
+    }
+    docs.push_back(BSONObj());
+    docs.push_back(fromjson("{a: [1, 2]}"));
+    docs.push_back(BSON("a" << 100));
+
+    auto results = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQUALS(results.size(), docs.size());
+
+    for (size_t i = 0; i < docs.size(); i++) {
+        auto expected = [&]() -> StatusWith<ShardEndpoint> {
+            try {
+                return cmTargeter.targetInsert(operationContext(), docs[i]);
+            } catch (const DBException& ex) {
+                return ex.toStatus();
+            }
+        }();
+
+        ASSERT_EQUALS(results[i].getStatus().code(), expected.getStatus().code());
+        if (expected.isOK()) {
+            ASSERT_EQUALS(results[i].getValue().shardName, expected.getValue().shardName);
+            ASSERT_EQUALS(*results[i].getValue().shardVersion, *expected.getValue().shardVersion);
+        }
+    }
+
+    ASSERT_EQUALS(results[docs.size() - 2].getStatus(), ErrorCodes::ShardKeyNotFound);
+    ASSERT_EQUALS(results[docs.size() - 1].getValue().shardName, "4");
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetUpdateWithRangePrefixHashedShardKey) {
     // Create 5 chunks and 5 shards such that shardId '0' has chunk [MinKey, null), '1' has chunk
     // [null, -100), '2' has chunk [-100, 0), '3' has chunk ['0', 100) and '4' has chunk
@@ -132,6 +132,48 @@ TEST_F(ChunkMapTest, TestIntersectingChunk) {
                                                        BSON("a" << 100)));
 }
 
+TEST_F(ChunkMapTest, TestIntersectingChunkAfterIncrementalMerge) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    auto initialChunkMap = chunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(
+             ChunkType{kNss,
+                       ChunkRange{getShardKeyPattern().globalMin(), BSON("a" << 0)},
+                       version,
+                       kThisShard}),
+
+         std::make_shared<ChunkInfo>(
+             ChunkType{kNss, ChunkRange{BSON("a" << 0), BSON("a" << 100)}, version, kThisShard}),
+
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss,
+             ChunkRange{BSON("a" << 100), getShardKeyPattern().globalMax()},
+             version,
+             kThisShard})});
+
+    // Split the middle chunk.
+    version.incMajor();
+    auto lowerHalf = std::make_shared<ChunkInfo>(
+        ChunkType{kNss, ChunkRange{BSON("a" << 0), BSON("a" << 50)}, version, kThisShard});
+    version.incMinor();
+    auto upperHalf = std::make_shared<ChunkInfo>(
+        ChunkType{kNss, ChunkRange{BSON("a" << 50), BSON("a" << 100)}, version, kThisShard});
+    auto newChunkMap = initialChunkMap.createMerged({lowerHalf, upperHalf});
+
+    ASSERT_EQ(newChunkMap.size(), 4);
+    ASSERT_EQ(newChunkMap.findIntersectingChunk(BSON("a" << -10))->getMax().woCompare(
+                  BSON("a" << 0)),
+              0);
+    ASSERT_EQ(newChunkMap.findIntersectingChunk(BSON("a" << 0)), lowerHalf);
+    ASSERT_EQ(newChunkMap.findIntersectingChunk(BSON("a" << 49)), lowerHalf);
+    ASSERT_EQ(newChunkMap.findIntersectingChunk(BSON("a" << 50)), upperHalf);
+    ASSERT_EQ(newChunkMap.findIntersectingChunk(BSON("a" << 100))->getMin().woCompare(
+                  BSON("a" << 100)),
+              0);
+}
+
 TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     const OID epoch = OID::gen();
     ChunkMap chunkMap{epoch, boost::none /* timestamp */};
@@ -165,4 +207,88 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestIncrementalMergeSharesUntouchedBlocks) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    const int nChunks = 5 * ChunkMap::kMaxChunksPerBlock;
+    auto rangeFor = [&](int i) {
+        return ChunkRange{i == 0 ? getShardKeyPattern().globalMin() : BSON("a" << i * 10),
+                          i == nChunks - 1 ? getShardKeyPattern().globalMax()
+                                           : BSON("a" << (i + 1) * 10)};
+    };
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    for (int i = 0; i < nChunks; ++i) {
+        chunks.push_back(
+            std::make_shared<ChunkInfo>(ChunkType{kNss, rangeFor(i), version, kThisShard}));
+    }
+    auto initialChunkMap = chunkMap.createMerged(chunks);
+    ASSERT_EQ(initialChunkMap.size(), nChunks);
+    ASSERT_EQ(initialChunkMap.numBlocks(), 5);
+
+    // Move a chunk in the middle of the third block.
+    const int movedChunkIndex = 2 * ChunkMap::kMaxChunksPerBlock + 7;
+    version.incMajor();
+    auto movedChunk = std::make_shared<ChunkInfo>(
+        ChunkType{kNss, rangeFor(movedChunkIndex), version, ShardId("otherShard")});
+    auto newChunkMap = initialChunkMap.createMerged({movedChunk});
+
+    ASSERT_EQ(newChunkMap.size(), nChunks);
+    ASSERT_EQ(newChunkMap.getVersion(), version);
+    ASSERT_EQ(newChunkMap.numBlocks(), 5);
+    ASSERT_EQ(newChunkMap.numBlocksSharedWith(initialChunkMap), 4);
+
+    for (int i = 0; i < nChunks; ++i) {
+        const auto expected = i == movedChunkIndex ? movedChunk : chunks[i];
+        ASSERT_EQ(newChunkMap.findIntersectingChunk(BSON("a" << i * 10 + 5)), expected);
+    }
+
+    int count = 0;
+    newChunkMap.forEachOverlappingChunk(BSON("a" << movedChunkIndex * 10 - 1),
+                                        BSON("a" << (movedChunkIndex + 1) * 10),
+                                        true,
+                                        [&](const auto& chunk) {
+                                            ++count;
+                                            return true;
+                                        });
+    ASSERT_EQ(count, 3);
+
+    // Split the last chunk of the first block, which makes that block overflow.
+    const int splitChunkIndex = ChunkMap::kMaxChunksPerBlock - 1;
+    version.incMajor();
+    auto lowerHalf = std::make_shared<ChunkInfo>(ChunkType{
+        kNss,
+        ChunkRange{BSON("a" << splitChunkIndex * 10), BSON("a" << splitChunkIndex * 10 + 5)},
+        version,
+        kThisShard});
+    version.incMinor();
+    auto upperHalf = std::make_shared<ChunkInfo>(ChunkType{
+        kNss,
+        ChunkRange{BSON("a" << splitChunkIndex * 10 + 5), BSON("a" << (splitChunkIndex + 1) * 10)},
+        version,
+        kThisShard});
+    auto splitChunkMap = newChunkMap.createMerged({lowerHalf, upperHalf});
+
+    ASSERT_EQ(splitChunkMap.size(), nChunks + 1);
+    ASSERT_EQ(splitChunkMap.findIntersectingChunk(BSON("a" << splitChunkIndex * 10)), lowerHalf);
+    ASSERT_EQ(splitChunkMap.findIntersectingChunk(BSON("a" << splitChunkIndex * 10 + 5)),
+              upperHalf);
+    ASSERT_EQ(splitChunkMap.findIntersectingChunk(BSON("a" << (splitChunkIndex + 1) * 10)),
+              chunks[splitChunkIndex + 1]);
+    ASSERT_GTE(splitChunkMap.numBlocksSharedWith(newChunkMap), 3);
+
+    auto lastMax = getShardKeyPattern().globalMin();
+    count = 0;
+    splitChunkMap.forEach([&](const auto& chunkInfo) {
+        ASSERT_BSONOBJ_EQ(chunkInfo->getMin(), lastMax);
+        lastMax = chunkInfo->getMax();
+        ++count;
+        return true;
+    });
+    ASSERT_EQ(count, nChunks + 1);
+    ASSERT_BSONOBJ_EQ(lastMax, getShardKeyPattern().globalMax());
+}
+
 }  // namespace mongo
@@ -106,6 +106,12 @@ public:
             if (getTestCommandsEnabled()) {
                 validateResult(bob.asTempObj());
             }
+
+            if (opCtx->isExhaust() && response.getCursorId() != 0) {
+                // Indicate that an exhaust message should be generated and the previous BSONObj
+                // command parameters should be reused as the next BSONObj command parameters.
+                reply->setNextInvocation(boost::none);
+            }
         }
 
         void validateResult(const BSONObj& replyObj) {
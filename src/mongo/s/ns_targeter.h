@@ -76,6 +76,26 @@ public:
      */
     virtual ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const = 0;
 
+    /**
+     * Returns one entry per document in 'docs', in the same order, holding either the
+     * ShardEndpoint of that document or the error targetInsert() would have thrown for it.
+     *
+     * The default implementation targets each document separately with targetInsert().
+     */
+    virtual std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+        std::vector<StatusWith<ShardEndpoint>> endpoints;
+        endpoints.reserve(docs.size());
+        for (const auto& doc : docs) {
+            try {
+                endpoints.emplace_back(targetInsert(opCtx, doc));
+            } catch (const DBException& ex) {
+                endpoints.emplace_back(ex.toStatus());
+            }
+        }
+        return endpoints;
+    }
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard update or throws
      * ShardKeyNotFound if 'updateOp' misses a shard key, but the type of update requires it.
@@ -378,7 +378,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     invariant(_remotes[smallestRemote].status.isOK());
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
-    _remotes[smallestRemote].docBuffer.pop();
+    _remotes[smallestRemote].popFront();
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
@@ -405,7 +405,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
 
         if (_remotes[_gettingFromRemote].hasNext()) {
             ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
-            _remotes[_gettingFromRemote].docBuffer.pop();
+            _remotes[_gettingFromRemote].popFront();
 
             if (_tailableMode == TailableModeEnum::kTailable &&
                 !_remotes[_gettingFromRemote].hasNext()) {
@@ -518,6 +518,43 @@ Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
     return Status::OK();
 }
 
+Status AsyncResultsMerger::prefetchNextBatches(long long maxBufferedBytes) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(_opCtx, "Cannot prefetch without an OperationContext");
+
+    if (_lifecycleState != kAlive || _tailableMode != TailableModeEnum::kNormal ||
+        _params.getTxnNumber() || _opCtx->hasDeadline()) {
+        return Status::OK();
+    }
+
+    long long projectedBytes = 0;
+    for (const auto& remote : _remotes) {
+        projectedBytes += remote.bufferedBytes;
+    }
+
+    for (size_t i = 0; i < _remotes.size(); ++i) {
+        auto& remote = _remotes[i];
+        if (!remote.status.isOK()) {
+            return remote.status;
+        }
+
+        if (remote.hasNext() || remote.exhausted() || remote.cbHandle.isValid()) {
+            continue;
+        }
+
+        projectedBytes += remote.lastBatchBytes;
+        if (projectedBytes > maxBufferedBytes) {
+            break;
+        }
+
+        auto nextBatchStatus = _askForNextBatch(lk, i);
+        if (!nextBatchStatus.isOK()) {
+            return nextBatchStatus;
+        }
+    }
+    return Status::OK();
+}
+
 /*
  * Note: When nextEvent() is called to do retries, only the remotes with retriable errors will
  * be rescheduled because:
@@ -736,6 +773,8 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        remote.bufferedBytes = 0;
+        remote.frontSortKey = boost::none;
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -791,6 +830,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
     _updateRemoteMetadata(lk, remoteIndex, response);
+    remote.lastBatchBytes = 0;
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
         if (_params.getSort()) {
@@ -812,6 +852,8 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
 
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
+        remote.bufferedBytes += obj.objsize();
+        remote.lastBatchBytes += obj.objsize();
         ++remote.fetchedCount;
     }
 
@@ -920,11 +962,23 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
     return cursorId == 0;
 }
 
+void AsyncResultsMerger::RemoteCursorData::popFront() {
+    if (auto doc = docBuffer.front().getResult()) {
+        bufferedBytes -= doc->objsize();
+    }
+    docBuffer.pop();
+    frontSortKey = boost::none;
+}
+
 //
 // AsyncResultsMerger::MergingComparator
 //
 
 bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
+    if (_useKeyString) {
+        return _frontSortKey(_remotes[lhs]).compare(_frontSortKey(_remotes[rhs])) > 0;
+    }
+
     const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
     const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
 
@@ -933,6 +987,21 @@ bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const
                            _sort) > 0;
 }
 
+const KeyString::Value& AsyncResultsMerger::MergingComparator::_frontSortKey(
+    const RemoteCursorData& remote) const {
+    if (!remote.frontSortKey) {
+        // As in compareSortKeys(), no collator is needed here since strings in the sort key have
+        // already been mapped to their comparison keys by mongod. The KeyString ordering agrees
+        // with the BSON ordering used by compareSortKeys() for the same sort pattern.
+        KeyString::Builder builder(
+            KeyString::Version::kLatestVersion,
+            extractSortKey(*remote.docBuffer.front().getResult(), _compareWholeSortKey),
+            _ordering);
+        remote.frontSortKey = builder.getValueCopy();
+    }
+    return *remote.frontSortKey;
+}
+
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
     const MinSortKeyRemoteIdPair& lhs, const MinSortKeyRemoteIdPair& rhs) const {
     auto sortKeyComp = compareSortKeys(lhs.first, rhs.first, _sort);
@@ -36,6 +36,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
@@ -205,6 +206,21 @@ public:
      */
     Status scheduleGetMores();
 
+    /**
+     * Speculatively schedules getMore requests on the remotes that scheduleGetMores() would, so
+     * that their next batches are already buffered, or in flight, when the caller next asks for
+     * results. Requests are only scheduled while the bytes currently buffered plus the size of the
+     * previous batch from each remote being prefetched stay within 'maxBufferedBytes'.
+     *
+     * Does nothing for tailable cursors, cursors belonging to a multi-statement transaction, or if
+     * the attached OperationContext has a deadline, since a prefetched getMore would otherwise
+     * block on awaitData, conflict with the transaction's next statement, or inherit a deadline
+     * which only bounds the current operation.
+     *
+     * Must be called while the ARM is attached to an OperationContext.
+     */
+    Status prefetchNextBatches(long long maxBufferedBytes);
+
     /**
      * Adds the specified shard cursors to the set of cursors to be merged.  The results from the
      * new cursors will be returned as normal through nextReady().
@@ -274,6 +290,12 @@ private:
          */
         bool exhausted() const;
 
+        /**
+         * Removes the result at the front of 'docBuffer'. Also discards the cached sort key of that
+         * result, if any.
+         */
+        void popFront();
+
         // Used when merging tailable awaitData cursors in sorted order. In order to return any
         // result to the client we have to know that no shard will ever return anything that sorts
         // before it. This object represents a promise from the remote that it will never return a
@@ -306,6 +328,11 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // KeyString encoding of the sort key of the result at the front of 'docBuffer'. Populated
+        // lazily by the MergingComparator so that each buffered result is encoded once, rather
+        // than having its $sortKey extracted and compared field-by-field on every heap operation.
+        mutable boost::optional<KeyString::Value> frontSortKey;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -317,6 +344,13 @@ private:
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
 
+        // Total size of the documents in 'docBuffer'.
+        long long bufferedBytes = 0;
+
+        // Total size of the documents in the most recent batch received from this remote. Used to
+        // estimate the size of the next batch when deciding whether to prefetch it.
+        long long lastBatchBytes = 0;
+
         // If set to 'true', the cursor on this shard has been invalidated.
         bool invalidated = false;
     };
@@ -326,15 +360,30 @@ private:
         MergingComparator(const std::vector<RemoteCursorData>& remotes,
                           const BSONObj& sort,
                           bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+            : _remotes(remotes),
+              _sort(sort),
+              _useKeyString(static_cast<size_t>(sort.nFields()) <= Ordering::kMaxCompoundIndexKeys),
+              _ordering(_useKeyString ? Ordering::make(sort) : Ordering::allAscending()),
+              _compareWholeSortKey(compareWholeSortKey) {}
 
         bool operator()(const size_t& lhs, const size_t& rhs);
 
     private:
+        /**
+         * Returns the KeyString encoding of the sort key of the result at the front of 'remote',
+         * computing and caching it on the remote if it has not been computed yet.
+         */
+        const KeyString::Value& _frontSortKey(const RemoteCursorData& remote) const;
+
         const std::vector<RemoteCursorData>& _remotes;
 
         const BSONObj _sort;
 
+        // Sort keys are compared as KeyStrings whenever the sort pattern can be expressed as an
+        // Ordering. Otherwise the comparator falls back to comparing the BSON sort keys.
+        const bool _useKeyString;
+        const Ordering _ordering;
+
         // When '_compareWholeSortKey' is true, $sortKey is a scalar value, rather than an object.
         // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
         // be {$sortKey: 1}.
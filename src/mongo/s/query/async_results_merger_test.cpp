@@ -440,6 +440,51 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, CompoundSortKeyWithMixedTypes) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: 1, b: -1}}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[2], kTestShardHosts[2], CursorResponse(kTestNss, 7, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_FALSE(arm->ready());
+
+    // Numbers of different types must compare by value, and values of different types must
+    // compare in BSON canonical type order.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {BSON("$sortKey" << BSON_ARRAY(1 << "z")),
+                                   BSON("$sortKey" << BSON_ARRAY(2.5 << "a"))};
+    responses.emplace_back(kTestNss, CursorId(0), batch1);
+    std::vector<BSONObj> batch2 = {BSON("$sortKey" << BSON_ARRAY(1LL << "b")),
+                                   BSON("$sortKey" << BSON_ARRAY("str" << 5))};
+    responses.emplace_back(kTestNss, CursorId(0), batch2);
+    std::vector<BSONObj> batch3 = {BSON("$sortKey" << BSON_ARRAY(BSONNULL << 0)),
+                                   BSON("$sortKey" << BSON_ARRAY(2 << BSON("x" << 1)))};
+    responses.emplace_back(kTestNss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    std::vector<BSONObj> expected = {BSON("$sortKey" << BSON_ARRAY(BSONNULL << 0)),
+                                     BSON("$sortKey" << BSON_ARRAY(1 << "z")),
+                                     BSON("$sortKey" << BSON_ARRAY(1LL << "b")),
+                                     BSON("$sortKey" << BSON_ARRAY(2 << BSON("x" << 1))),
+                                     BSON("$sortKey" << BSON_ARRAY(2.5 << "a")),
+                                     BSON("$sortKey" << BSON_ARRAY("str" << 5))};
+    for (auto&& expectedObj : expected) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(expectedObj, *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
@@ -525,6 +570,72 @@ TEST_F(AsyncResultsMergerTest, HasFirstBatch) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, PrefetchRequestsNextBatchOnceBufferIsConsumed) {
+    std::vector<BSONObj> firstBatch = {fromjson("{_id: 1}")};
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, std::move(firstBatch))));
+    auto arm = makeARMFromExistingCursors(std::move(cursors));
+
+    // Nothing is prefetched while the remote still has buffered results.
+    ASSERT_OK(arm->prefetchNextBatches(1024 * 1024));
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(arm->ready());
+
+    // Once the buffer is drained, the getMore is sent without waiting for nextEvent().
+    ASSERT_OK(arm->prefetchNextBatches(1024 * 1024));
+    ASSERT_TRUE(networkHasReadyRequests());
+    ASSERT_EQ(getNthPendingRequest(0).cmdObj["getMore"].numberLong(), 5);
+
+    std::vector<BSONObj> batch = {fromjson("{_id: 2}"), fromjson("{_id: 3}")};
+    scheduleNetworkResponse({kTestNss, CursorId(0), batch});
+
+    // The prefetched batch is buffered, so the next results are available immediately.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 3}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, PrefetchRespectsMaxBufferedBytes) {
+    const BSONObj firstDoc = fromjson("{_id: 1}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {firstDoc})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors));
+
+    ASSERT_BSONOBJ_EQ(firstDoc, *unittest::assertGet(arm->nextReady()).getResult());
+
+    // The next batch is expected to be as large as the last one, which exceeds the budget.
+    ASSERT_OK(arm->prefetchNextBatches(firstDoc.objsize() - 1));
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    ASSERT_OK(arm->prefetchNextBatches(firstDoc.objsize()));
+    ASSERT_TRUE(networkHasReadyRequests());
+
+    scheduleNetworkResponse({kTestNss, CursorId(0), {}});
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, PrefetchSkipsTailableCursors) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', tailable: true}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    ASSERT_OK(arm->prefetchNextBatches(1024 * 1024));
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    auto killFuture = arm->kill(operationContext());
+    killFuture.wait();
+}
+
 TEST_F(AsyncResultsMergerTest, OneShardHasInitialBatchOtherShardExhausted) {
     std::vector<BSONObj> firstBatch = {
         fromjson("{_id: 1}"), fromjson("{_id: 2}"), fromjson("{_id: 3}")};
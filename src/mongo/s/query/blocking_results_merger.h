@@ -68,6 +68,10 @@ public:
         return _arm.remotesExhausted();
     }
 
+    Status prefetchNextBatches(long long maxBufferedBytes) {
+        return _arm.prefetchNextBatches(maxBufferedBytes);
+    }
+
     bool partialResultsReturned() const {
         return _arm.partialResultsReturned();
     }
@@ -157,6 +157,13 @@ public:
      */
     virtual bool remotesExhausted() = 0;
 
+    /**
+     * Starts retrieving the next batch from remotes whose buffered results have been consumed, so
+     * that the next getMore does not have to wait on a round trip to the shards. Stops once the
+     * results buffered for this cursor could exceed 'maxBufferedBytes'.
+     */
+    virtual Status prefetchNextBatches(long long maxBufferedBytes) = 0;
+
     /**
      * Sets the maxTimeMS value that the cursor should forward with any internally issued getMore
      * requests.
@@ -189,6 +189,10 @@ bool ClusterClientCursorImpl::remotesExhausted() {
     return _root->remotesExhausted();
 }
 
+Status ClusterClientCursorImpl::prefetchNextBatches(long long maxBufferedBytes) {
+    return _root->prefetchNextBatches(maxBufferedBytes);
+}
+
 Status ClusterClientCursorImpl::setAwaitDataTimeout(Milliseconds awaitDataTimeout) {
     return _root->setAwaitDataTimeout(awaitDataTimeout);
 }
@@ -96,6 +96,8 @@ public:
 
     bool remotesExhausted() final;
 
+    Status prefetchNextBatches(long long maxBufferedBytes) final;
+
     Status setAwaitDataTimeout(Milliseconds awaitDataTimeout) final;
 
     boost::optional<LogicalSessionId> getLsid() const final;
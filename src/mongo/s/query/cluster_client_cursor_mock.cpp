@@ -144,6 +144,10 @@ Status ClusterClientCursorMock::setAwaitDataTimeout(Milliseconds awaitDataTimeou
     MONGO_UNREACHABLE;
 }
 
+Status ClusterClientCursorMock::prefetchNextBatches(long long maxBufferedBytes) {
+    return Status::OK();
+}
+
 boost::optional<LogicalSessionId> ClusterClientCursorMock::getLsid() const {
     return _lsid;
 }
@@ -86,6 +86,8 @@ public:
 
     Status setAwaitDataTimeout(Milliseconds awaitDataTimeout) final;
 
+    Status prefetchNextBatches(long long maxBufferedBytes) final;
+
     boost::optional<LogicalSessionId> getLsid() const final;
 
     boost::optional<TxnNumber> getTxnNumber() const final;
@@ -64,6 +64,7 @@
 #include "mongo/s/query/async_results_merger.h"
 #include "mongo/s/query/cluster_client_cursor_impl.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/establish_cursors.h"
 #include "mongo/s/query/store_possible_cursor.h"
 #include "mongo/s/stale_exception.h"
@@ -89,6 +90,26 @@ static const int kPerDocumentOverheadBytesUpperBound = 10;
 
 const char kFindCmdName[] = "find";
 
+/**
+ * If clusterCursorPrefetchMaxBufferedBytes is set, asks the shards for the cursor's next batches
+ * before the batch just built is returned to the client. A failure to schedule the requests is
+ * not fatal to the current operation; the next getMore will run them itself.
+ */
+template <typename CursorHandle>
+void prefetchNextBatches(CursorHandle& cursor) {
+    const auto maxBufferedBytes = gClusterCursorPrefetchMaxBufferedBytes.load();
+    if (maxBufferedBytes <= 0) {
+        return;
+    }
+
+    if (auto status = cursor->prefetchNextBatches(maxBufferedBytes); !status.isOK()) {
+        LOGV2_DEBUG(7100506,
+                    2,
+                    "Failed to prefetch the next batches of a cursor",
+                    "error"_attr = status);
+    }
+}
+
 /**
  * Given the FindCommandRequest 'findCommand' being executed by mongos, returns a copy of the query
  * which is suitable for forwarding to the targeted hosts.
@@ -355,6 +376,11 @@ CursorId runQueryWithoutRetrying(OperationContext* opCtx,
         results->push_back(std::move(nextObj));
     }
 
+    if (cursorState == ClusterCursorManager::CursorState::NotExhausted &&
+        !findCommand.getSingleBatch()) {
+        prefetchNextBatches(ccc);
+    }
+
     ccc->detachFromOperationContext();
 
     if (findCommand.getSingleBatch() && !ccc->isTailable()) {
@@ -822,6 +848,10 @@ StatusWith<CursorResponse> ClusterFind::runGetMore(OperationContext* opCtx,
         postBatchResumeToken = pinnedCursor.getValue()->getPostBatchResumeToken();
     }
 
+    if (idToReturn) {
+        prefetchNextBatches(pinnedCursor.getValue());
+    }
+
     const bool partialResultsReturned = pinnedCursor.getValue()->partialResultsReturned();
     pinnedCursor.getValue()->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
     pinnedCursor.getValue()->incNBatches();
@@ -35,9 +35,11 @@
 #include "mongo/client/remote_command_targeter_mock.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/cursor_response.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/query/establish_cursors.h"
+#include "mongo/s/replica_latency_tracker.h"
 #include "mongo/s/sharding_router_test_fixture.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/unittest.h"
@@ -206,6 +208,56 @@ TEST_F(EstablishCursorsTest, SingleRemoteInterruptedWhileCommandInFlight) {
     future.default_timed_get();
 }
 
+TEST_F(EstablishCursorsTest, InterruptedWhileCommandInFlightReleasesReplicaLatencyTracker) {
+    RAIIServerParameterControllerForTest adaptiveSelection("readAdaptiveReplicaSelection", true);
+    auto tracker = ReplicaLatencyTracker::get(getServiceContext());
+
+    BSONObj cmdObj = fromjson("{find: 'testcoll'}");
+    std::vector<std::pair<ShardId, BSONObj>> remotes{
+        {kTestShardIds[0], cmdObj},
+    };
+
+    auto barrier = std::make_shared<unittest::Barrier>(2);
+    auto future = launchAsync([&] {
+        ASSERT_THROWS(establishCursors(operationContext(),
+                                       executor(),
+                                       _nss,
+                                       ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+                                       remotes,
+                                       false),  // allowPartialResults
+                      ExceptionFor<ErrorCodes::CursorKilled>);
+        barrier->countDownAndWait();
+    });
+
+    onCommand([&](const RemoteCommandRequest& request) {
+        ASSERT_EQ(1, tracker->getNumInFlight(kTestShardHosts[0]));
+
+        {
+            stdx::lock_guard<Client> lk(*operationContext()->getClient());
+            operationContext()->getServiceContext()->killOperation(
+                lk, operationContext(), ErrorCodes::CursorKilled);
+        }
+
+        // Respond only once the ARS has been interrupted and stopped servicing its sub-baton, so
+        // the response is delivered after the ARS has given up on it.
+        barrier->countDownAndWait();
+
+        CursorResponse cursorResponse(_nss, CursorId(123), {});
+        return cursorResponse.toBSON(CursorResponse::ResponseType::InitialResponse);
+    });
+
+    expectKillOperations(1);
+
+    future.default_timed_get();
+
+    // The response is handed to the executor callback asynchronously.
+    const auto deadline = Date_t::now() + Seconds(30);
+    while (tracker->getNumInFlight(kTestShardHosts[0]) != 0 && Date_t::now() < deadline) {
+        sleepmillis(1);
+    }
+    ASSERT_EQ(0, tracker->getNumInFlight(kTestShardHosts[0]));
+}
+
 TEST_F(EstablishCursorsTest, SingleRemoteRespondsWithNonretriableErrorAllowPartialResults) {
     BSONObj cmdObj = fromjson("{find: 'testcoll'}");
     std::vector<std::pair<ShardId, BSONObj>> remotes{{kTestShardIds[0], cmdObj}};
@@ -107,6 +107,14 @@ public:
         return _child->remotesExhausted();
     }
 
+    /**
+     * Starts retrieving the next batches of the remote cursors feeding this execution plan in the
+     * background. Default implementation forwards to the stage's child, if any.
+     */
+    virtual Status prefetchNextBatches(long long maxBufferedBytes) {
+        return _child ? _child->prefetchNextBatches(maxBufferedBytes) : Status::OK();
+    }
+
     /**
      * Sets the maxTimeMS value that the cursor should forward with any internally issued getMore
      * requests.
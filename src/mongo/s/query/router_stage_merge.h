@@ -63,6 +63,10 @@ public:
         return _resultsMerger.remotesExhausted();
     }
 
+    Status prefetchNextBatches(long long maxBufferedBytes) final {
+        return _resultsMerger.prefetchNextBatches(maxBufferedBytes);
+    }
+
     bool partialResultsReturned() const final {
         return _resultsMerger.partialResultsReturned();
     }
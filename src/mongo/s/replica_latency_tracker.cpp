@@ -0,0 +1,172 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/replica_latency_tracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getReplicaLatencyTracker = ServiceContext::declareDecoration<ReplicaLatencyTracker>();
+
+}  // namespace
+
+ReplicaLatencyTracker* ReplicaLatencyTracker::get(ServiceContext* serviceContext) {
+    return &getReplicaLatencyTracker(serviceContext);
+}
+
+void ReplicaLatencyTracker::onRequestStarted(const HostAndPort& host) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    ++_hosts[host].inFlight;
+}
+
+void ReplicaLatencyTracker::onRequestFinished(const HostAndPort& startedHost,
+                                              const boost::optional<HostAndPort>& respondingHost,
+                                              const boost::optional<Microseconds>& elapsed,
+                                              Date_t now) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto& started = _hosts[startedHost];
+    invariant(started.inFlight > 0);
+    --started.inFlight;
+
+    if (respondingHost && elapsed) {
+        auto& responding = _hosts[*respondingHost];
+        const auto sample = static_cast<double>(durationCount<Microseconds>(*elapsed));
+        if (responding.lastSampleDate == Date_t()) {
+            responding.latencyMicros = sample;
+        } else {
+            responding.latencyMicros =
+                kLatencyAlpha * sample + (1 - kLatencyAlpha) * responding.latencyMicros;
+        }
+        responding.lastSampleDate = now;
+    }
+
+    if (now - _lastPruneDate >= kPruneInterval) {
+        _pruneIdleHosts(lk, now);
+    }
+}
+
+void ReplicaLatencyTracker::orderByExpectedLatency(std::vector<HostAndPort>* hosts,
+                                                   Date_t now,
+                                                   Milliseconds sampleExpiration) const {
+    if (hosts->size() < 2) {
+        return;
+    }
+
+    std::vector<std::pair<double, HostAndPort>> ranked;
+    ranked.reserve(hosts->size());
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto& host : *hosts) {
+            ranked.emplace_back(_expectedLatencyMicros(lk, host, now, sampleExpiration),
+                                std::move(host));
+        }
+    }
+
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        (*hosts)[i] = std::move(ranked[i].second);
+    }
+}
+
+Microseconds ReplicaLatencyTracker::getExpectedLatency(const HostAndPort& host,
+                                                       Date_t now,
+                                                       Milliseconds sampleExpiration) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return Microseconds(
+        static_cast<long long>(_expectedLatencyMicros(lk, host, now, sampleExpiration)));
+}
+
+int ReplicaLatencyTracker::getNumInFlight(const HostAndPort& host) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _hosts.find(host);
+    return it == _hosts.end() ? 0 : it->second.inFlight;
+}
+
+size_t ReplicaLatencyTracker::getNumHosts() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _hosts.size();
+}
+
+void ReplicaLatencyTracker::_pruneIdleHosts(WithLock, Date_t now) {
+    for (auto it = _hosts.begin(); it != _hosts.end();) {
+        auto current = it++;
+        if (current->second.inFlight == 0 &&
+            now - current->second.lastSampleDate > kIdleHostExpiration) {
+            _hosts.erase(current);
+        }
+    }
+    _lastPruneDate = now;
+}
+
+double ReplicaLatencyTracker::_expectedLatencyMicros(WithLock,
+                                                     const HostAndPort& host,
+                                                     Date_t now,
+                                                     Milliseconds sampleExpiration) const {
+    const auto defaultLatencyMicros =
+        static_cast<double>(durationCount<Microseconds>(kDefaultLatency));
+    auto it = _hosts.find(host);
+    if (it == _hosts.end()) {
+        return defaultLatencyMicros;
+    }
+
+    const auto& stats = it->second;
+    auto latencyMicros = defaultLatencyMicros;
+    if (stats.lastSampleDate != Date_t()) {
+        latencyMicros = stats.latencyMicros;
+
+        // Without fresh samples the estimate becomes less trustworthy, so move it towards the
+        // default rather than dropping it, which would send every read to a host that is too slow
+        // to be sampled within the expiration.
+        const auto expiredFor = now - stats.lastSampleDate - sampleExpiration;
+        if (expiredFor > Milliseconds(0)) {
+            const auto halfLives = static_cast<double>(durationCount<Milliseconds>(expiredFor)) /
+                std::max<long long>(durationCount<Milliseconds>(sampleExpiration), 1);
+            latencyMicros = defaultLatencyMicros +
+                (latencyMicros - defaultLatencyMicros) * std::pow(0.5, halfLives);
+        }
+    }
+
+    // Every command already outstanding against the host is expected to be served before a new
+    // one, so scale the latency estimate by the depth of that queue.
+    return latencyMicros * (1 + stats.inFlight);
+}
+
+}  // namespace mongo
@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/net/hostandport.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Keeps per-host estimates of how long remote commands take to complete, and how many commands are
+ * currently outstanding against each host. Used for adaptive replica selection, which orders the
+ * hosts eligible for a read so that the one with the lowest expected latency is tried first.
+ *
+ * The latency estimate is an exponentially weighted moving average of the round trip times of
+ * the commands sent to the host, so it accounts for the load on the remote node, unlike the
+ * heartbeat-based round trip times used to compute the server selection latency window.
+ *
+ * This class is thread-safe.
+ */
+class ReplicaLatencyTracker {
+public:
+    // Weight given to the most recent sample in the moving average of a host's latency.
+    static constexpr double kLatencyAlpha = 0.2;
+
+    // Latency assumed for hosts that have never been sampled, and towards which the estimate of a
+    // host decays once its last sample has expired.
+    static constexpr Microseconds kDefaultLatency{1000};
+
+    // Hosts with no outstanding commands and no latency sample for this long are forgotten, so that
+    // hosts removed from the topology do not accumulate.
+    static constexpr Minutes kIdleHostExpiration{10};
+
+    // How often onRequestFinished looks for idle hosts to forget.
+    static constexpr Minutes kPruneInterval{1};
+
+    static ReplicaLatencyTracker* get(ServiceContext* serviceContext);
+
+    /**
+     * Notes that a command was sent to 'host'. Must be paired with a call to onRequestFinished.
+     */
+    void onRequestStarted(const HostAndPort& host);
+
+    /**
+     * Notes that a command previously sent to 'startedHost' has finished. If 'respondingHost' and
+     * 'elapsed' are set, folds the round trip time into the latency estimate of 'respondingHost',
+     * which may differ from 'startedHost' for hedged reads.
+     */
+    void onRequestFinished(const HostAndPort& startedHost,
+                           const boost::optional<HostAndPort>& respondingHost,
+                           const boost::optional<Microseconds>& elapsed,
+                           Date_t now);
+
+    /**
+     * Stably reorders 'hosts' by increasing expected latency, which is the latency estimate of the
+     * host scaled by the number of commands outstanding against it. Hosts that were never sampled
+     * are estimated at kDefaultLatency. Once the last sample of a host is older than
+     * 'sampleExpiration', its estimate decays towards kDefaultLatency, halving the difference every
+     * 'sampleExpiration', so that hosts that have recovered from a slow period get probed again
+     * without all reads rushing to them at once.
+     */
+    void orderByExpectedLatency(std::vector<HostAndPort>* hosts,
+                                Date_t now,
+                                Milliseconds sampleExpiration) const;
+
+    /**
+     * Returns the expected latency of 'host', as used by orderByExpectedLatency.
+     */
+    Microseconds getExpectedLatency(const HostAndPort& host,
+                                    Date_t now,
+                                    Milliseconds sampleExpiration) const;
+
+    /**
+     * Returns the number of commands outstanding against 'host'. Used for testing.
+     */
+    int getNumInFlight(const HostAndPort& host) const;
+
+    /**
+     * Returns the number of hosts with tracked state. Used for testing.
+     */
+    size_t getNumHosts() const;
+
+private:
+    struct HostStats {
+        double latencyMicros = 0;
+        Date_t lastSampleDate;
+        int inFlight = 0;
+    };
+
+    double _expectedLatencyMicros(WithLock,
+                                  const HostAndPort& host,
+                                  Date_t now,
+                                  Milliseconds sampleExpiration) const;
+
+    void _pruneIdleHosts(WithLock, Date_t now);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ReplicaLatencyTracker::_mutex");
+    stdx::unordered_map<HostAndPort, HostStats> _hosts;
+    Date_t _lastPruneDate;
+};
+
+}  // namespace mongo
@@ -0,0 +1,179 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/replica_latency_tracker.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const HostAndPort kHostA("a", 27017);
+const HostAndPort kHostB("b", 27017);
+const HostAndPort kHostC("c", 27017);
+const Milliseconds kExpiration(1000);
+
+void recordSample(ReplicaLatencyTracker* tracker,
+                  const HostAndPort& host,
+                  Microseconds elapsed,
+                  Date_t now) {
+    tracker->onRequestStarted(host);
+    tracker->onRequestFinished(host, host, elapsed, now);
+}
+
+TEST(ReplicaLatencyTrackerTest, HostsWithoutSamplesKeepTheirOrder) {
+    ReplicaLatencyTracker tracker;
+    std::vector<HostAndPort> hosts{kHostA, kHostB, kHostC};
+    tracker.orderByExpectedLatency(&hosts, Date_t::now(), kExpiration);
+    ASSERT_TRUE((hosts == std::vector<HostAndPort>{kHostA, kHostB, kHostC}));
+}
+
+TEST(ReplicaLatencyTrackerTest, OrdersHostsByLatency) {
+    ReplicaLatencyTracker tracker;
+    const auto now = Date_t::now();
+    recordSample(&tracker, kHostA, Microseconds(3000), now);
+    recordSample(&tracker, kHostB, Microseconds(1000), now);
+    recordSample(&tracker, kHostC, Microseconds(2000), now);
+
+    std::vector<HostAndPort> hosts{kHostA, kHostB, kHostC};
+    tracker.orderByExpectedLatency(&hosts, now, kExpiration);
+    ASSERT_TRUE((hosts == std::vector<HostAndPort>{kHostB, kHostC, kHostA}));
+}
+
+TEST(ReplicaLatencyTrackerTest, LatencyIsAMovingAverage) {
+    ReplicaLatencyTracker tracker;
+    const auto now = Date_t::now();
+    recordSample(&tracker, kHostA, Microseconds(1000), now);
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now, kExpiration), Microseconds(1000));
+
+    recordSample(&tracker, kHostA, Microseconds(6000), now);
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now, kExpiration), Microseconds(2000));
+}
+
+TEST(ReplicaLatencyTrackerTest, OutstandingRequestsIncreaseExpectedLatency) {
+    ReplicaLatencyTracker tracker;
+    const auto now = Date_t::now();
+    recordSample(&tracker, kHostA, Microseconds(1000), now);
+    recordSample(&tracker, kHostB, Microseconds(1500), now);
+
+    tracker.onRequestStarted(kHostA);
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now, kExpiration), Microseconds(2000));
+
+    std::vector<HostAndPort> hosts{kHostA, kHostB};
+    tracker.orderByExpectedLatency(&hosts, now, kExpiration);
+    ASSERT_TRUE((hosts == std::vector<HostAndPort>{kHostB, kHostA}));
+
+    // A failed request only releases its slot, without contributing a latency sample.
+    tracker.onRequestFinished(kHostA, boost::none, boost::none, now);
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now, kExpiration), Microseconds(1000));
+}
+
+TEST(ReplicaLatencyTrackerTest, HostsWithoutSamplesUseDefaultLatency) {
+    ReplicaLatencyTracker tracker;
+    const auto now = Date_t::now();
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now, kExpiration),
+              ReplicaLatencyTracker::kDefaultLatency);
+
+    tracker.onRequestStarted(kHostA);
+    tracker.onRequestStarted(kHostA);
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now, kExpiration),
+              ReplicaLatencyTracker::kDefaultLatency * 3);
+
+    recordSample(&tracker, kHostB, ReplicaLatencyTracker::kDefaultLatency * 2, now);
+    std::vector<HostAndPort> hosts{kHostA, kHostB};
+    tracker.orderByExpectedLatency(&hosts, now, kExpiration);
+    ASSERT_TRUE((hosts == std::vector<HostAndPort>{kHostB, kHostA}));
+}
+
+TEST(ReplicaLatencyTrackerTest, ExpiredSamplesDecayTowardsDefaultLatency) {
+    ReplicaLatencyTracker tracker;
+    const auto now = Date_t::now();
+    const auto defaultLatency = ReplicaLatencyTracker::kDefaultLatency;
+    recordSample(&tracker, kHostA, defaultLatency * 5, now);
+
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now + kExpiration, kExpiration),
+              defaultLatency * 5);
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now + kExpiration * 2, kExpiration),
+              defaultLatency * 3);
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now + kExpiration * 3, kExpiration),
+              defaultLatency * 2);
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, now + kExpiration * 60, kExpiration),
+              defaultLatency);
+}
+
+TEST(ReplicaLatencyTrackerTest, SlowHostWithExpiredSampleRanksBelowFastHost) {
+    ReplicaLatencyTracker tracker;
+    const auto now = Date_t::now();
+    recordSample(&tracker, kHostA, Milliseconds(1500), now);
+    for (int i = 0; i < 3; ++i) {
+        tracker.onRequestStarted(kHostA);
+    }
+
+    // Host A answers too slowly to refresh its sample within the expiration, which must not make
+    // it look idle to every concurrent read.
+    const auto later = now + kExpiration + Milliseconds(500);
+    recordSample(&tracker, kHostB, Microseconds(500), later);
+
+    std::vector<HostAndPort> hosts{kHostA, kHostB};
+    tracker.orderByExpectedLatency(&hosts, later, kExpiration);
+    ASSERT_TRUE((hosts == std::vector<HostAndPort>{kHostB, kHostA}));
+}
+
+TEST(ReplicaLatencyTrackerTest, IdleHostsAreForgotten) {
+    ReplicaLatencyTracker tracker;
+    const auto now = Date_t::now();
+    recordSample(&tracker, kHostA, Microseconds(5000), now);
+    tracker.onRequestStarted(kHostB);
+    ASSERT_EQ(2U, tracker.getNumHosts());
+
+    // Host A has been idle for longer than the expiration, but host B still has a command
+    // outstanding, so only host A is forgotten.
+    const auto later = now + ReplicaLatencyTracker::kIdleHostExpiration + Milliseconds(1);
+    recordSample(&tracker, kHostC, Microseconds(1000), later);
+    ASSERT_EQ(2U, tracker.getNumHosts());
+    ASSERT_EQ(1, tracker.getNumInFlight(kHostB));
+    ASSERT_EQ(tracker.getExpectedLatency(kHostA, later, kExpiration),
+              ReplicaLatencyTracker::kDefaultLatency);
+    ASSERT_EQ(tracker.getExpectedLatency(kHostC, later, kExpiration), Microseconds(1000));
+}
+
+TEST(ReplicaLatencyTrackerTest, RecentlySampledHostsAreKept) {
+    ReplicaLatencyTracker tracker;
+    const auto now = Date_t::now();
+    recordSample(&tracker, kHostA, Microseconds(1000), now);
+
+    const auto later = now + ReplicaLatencyTracker::kPruneInterval;
+    recordSample(&tracker, kHostB, Microseconds(1000), later);
+    ASSERT_EQ(2U, tracker.getNumHosts());
+}
+
+}  // namespace
+}  // namespace mongo
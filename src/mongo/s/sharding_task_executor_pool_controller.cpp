@@ -54,6 +54,48 @@ void emplaceOrInvariant(Map&& map, Args&&... args) noexcept {
     invariant(ret.second, "Element already existed in map/set");
 }
 
+/**
+ * The number of connections reserved for each host by all of the
+ * ShardingTaskExecutorPoolControllers in the process.
+ */
+class HostConnectionBudget {
+public:
+    static HostConnectionBudget& get() {
+        static auto& budget = *new HostConnectionBudget();
+        return budget;
+    }
+
+    /**
+     * Replaces the 'previous' reservation of a pool for 'host' with up to 'desired' connections and
+     * returns the new reservation. A pool which wants connections is always granted at least one so
+     * that its requests can make progress, so the total may exceed 'limit' by at most one
+     * connection per pool.
+     */
+    size_t reserve(const HostAndPort& host, size_t previous, size_t desired, size_t limit) {
+        stdx::lock_guard lk(_mutex);
+
+        auto it = _reserved.find(host);
+        const size_t others = (it == _reserved.end() ? 0 : it->second) - previous;
+
+        auto granted = std::min(desired, limit > others ? limit - others : 0);
+        granted = std::max(granted, std::min<size_t>(desired, 1));
+
+        if (others + granted == 0) {
+            if (it != _reserved.end()) {
+                _reserved.erase(it);
+            }
+        } else {
+            _reserved[host] = others + granted;
+        }
+
+        return granted;
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("HostConnectionBudget::_mutex");
+    stdx::unordered_map<HostAndPort, size_t> _reserved;
+};
+
 }  // namespace
 
 Status ShardingTaskExecutorPoolController::validateHostTimeout(const int& hostTimeoutMS) {
@@ -281,6 +323,10 @@ void ShardingTaskExecutorPoolController::removeHost(PoolId id) {
     }
 
     auto& poolData = it->second;
+    if (poolData.reserved) {
+        HostConnectionBudget::get().reserve(poolData.host, poolData.reserved, 0, 0);
+    }
+
     auto& groupAndId = getOrInvariant(_groupAndIds, poolData.host);
     groupAndId.maybeId.reset();
     if (groupAndId.groupData) {
@@ -298,12 +344,24 @@ auto ShardingTaskExecutorPoolController::getControls(PoolId id) -> ConnectionCon
 
     const size_t maxPending = gParameters.maxConnecting.load();
 
+    auto target = poolData.target;
     auto groupData = poolData.groupData.lock();
-    if (!groupData || gParameters.matchingStrategy.load() == MatchingStrategy::kDisabled) {
-        return {maxPending, poolData.target};
+    if (groupData && gParameters.matchingStrategy.load() != MatchingStrategy::kDisabled) {
+        target = std::max(target, groupData->target);
+    }
+
+    const size_t maxAcrossExecutors = gParameters.maxConnectionsAcrossExecutors.load();
+    if (maxAcrossExecutors > 0 || poolData.reserved > 0) {
+        // A limit of zero releases whatever this pool reserved while the limit was set.
+        poolData.reserved = HostConnectionBudget::get().reserve(poolData.host,
+                                                                poolData.reserved,
+                                                                maxAcrossExecutors ? target : 0,
+                                                                maxAcrossExecutors);
+        if (maxAcrossExecutors > 0) {
+            target = poolData.reserved;
+        }
     }
 
-    auto target = std::max(poolData.target, groupData->target);
     return {maxPending, target};
 }
 
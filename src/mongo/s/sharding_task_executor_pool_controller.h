@@ -59,6 +59,13 @@ namespace mongo {
  * When the MatchingStrategy is kMatchBusiestNode, it operates like kMatchPrimaryNode, but any pool
  * can be responsible for increasing the targetConnections of each member of its set.
  *
+ * Each executor in the sharding TaskExecutorPool has its own ConnectionPool and controller, so
+ * maxConnections bounds the connections to a host from a single executor only. When
+ * maxConnectionsAcrossExecutors is set, every controller in the process additionally reserves its
+ * targetConnections for a host from a shared budget so that the total number of connections
+ * opened to that host stays within the limit. Requests beyond the limit wait for a connection to be
+ * returned to their pool instead of opening a new one.
+ *
  * Note that, in essence, there are three outside elements that can mutate the state of this class:
  * * The ReplicaSetChangeNotifier can notify the listener which updates the host groups
  * * The ServerParameters can update the Parameters which will used in the next update
@@ -94,6 +101,7 @@ public:
     public:
         AtomicWord<int> minConnections;
         AtomicWord<int> maxConnections;
+        AtomicWord<int> maxConnectionsAcrossExecutors;
         AtomicWord<int> maxConnecting;
 
         AtomicWord<int> hostTimeoutMS;
@@ -192,6 +200,10 @@ private:
         // The number of connections the host should maintain
         size_t target = 0;
 
+        // The number of connections reserved for this pool out of the budget shared by every
+        // controller when maxConnectionsAcrossExecutors is set
+        size_t reserved = 0;
+
         // This host is able to shutdown
         bool isAbleToShutdown = false;
     };
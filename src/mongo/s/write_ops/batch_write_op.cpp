@@ -60,6 +60,10 @@ struct WriteErrorDetailComp {
 const int kEstUpdateOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 const int kEstDeleteOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 
+// Number of insert documents handed to NSTargeter::targetInserts() at a time. Bounds the targeting
+// work that is thrown away when a targeted batch fills up before reaching the end of the window.
+const size_t kInsertTargetingWindowSize = 1024;
+
 /**
  * Returns a new write concern that has the copy of every field from the original
  * document but with a w set to 1. This is intended for upgrading { w: 0 } write
@@ -253,6 +257,37 @@ void trackErrors(const ShardEndpoint& endpoint,
     }
 }
 
+/**
+ * Targets the documents of the ready insert ops among 'writeOps[begin, begin + windowSize)' with a
+ * single call to NSTargeter::targetInserts(). The returned vector is indexed relative to 'begin'
+ * and only has entries for the ops which were ready.
+ */
+std::vector<boost::optional<StatusWith<ShardEndpoint>>> targetInsertWindow(
+    OperationContext* opCtx,
+    const NSTargeter& targeter,
+    const std::vector<WriteOp>& writeOps,
+    size_t begin) {
+    const size_t end = std::min(begin + kInsertTargetingWindowSize, writeOps.size());
+
+    std::vector<size_t> readyOps;
+    std::vector<BSONObj> docs;
+    for (size_t i = begin; i < end; ++i) {
+        if (writeOps[i].getWriteState() == WriteOpState_Ready) {
+            readyOps.push_back(i);
+            docs.push_back(writeOps[i].getWriteItem().getDocument());
+        }
+    }
+
+    auto endpoints = targeter.targetInserts(opCtx, docs);
+    invariant(endpoints.size() == docs.size());
+
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> window(end - begin);
+    for (size_t i = 0; i < readyOps.size(); ++i) {
+        window[readyOps[i] - begin].emplace(std::move(endpoints[i]));
+    }
+    return window;
+}
+
 }  // namespace
 
 BatchWriteOp::BatchWriteOp(OperationContext* opCtx, const BatchedCommandRequest& clientRequest)
@@ -310,6 +345,15 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // The documents of unordered inserts are targeted a window at a time, which lets the targeter
+    // extract and sort their shard keys together rather than look up a chunk for every document.
+    // Ordered batches stop at the first write going to a different shard, so their writes are
+    // still targeted one at a time.
+    const bool targetInsertWindows =
+        !ordered && _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert;
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> insertWindow;
+    size_t insertWindowBegin = 0;
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -327,7 +371,17 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
         Status targetStatus = Status::OK();
         try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
+            if (targetInsertWindows) {
+                if (i >= insertWindowBegin + insertWindow.size()) {
+                    insertWindowBegin = i;
+                    insertWindow = targetInsertWindow(_opCtx, targeter, _writeOps, i);
+                }
+                auto& swEndpoint = insertWindow[i - insertWindowBegin];
+                invariant(swEndpoint);
+                writeOp.targetInsertWrite(_opCtx, uassertStatusOK(std::move(*swEndpoint)), &writes);
+            } else {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            }
         } catch (const DBException& ex) {
             targetStatus = ex.toStatus();
         }
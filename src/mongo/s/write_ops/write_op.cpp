@@ -76,6 +76,20 @@ void WriteOp::targetWrites(OperationContext* opCtx,
         endpoints = targeter.targetAllShards(opCtx);
     }
 
+    _createTargetedWrites(std::move(endpoints), inTransaction, targetedWrites);
+}
+
+void WriteOp::targetInsertWrite(OperationContext* opCtx,
+                                ShardEndpoint endpoint,
+                                std::vector<TargetedWrite*>* targetedWrites) {
+    invariant(_itemRef.getOpType() == BatchedCommandRequest::BatchType_Insert);
+    _createTargetedWrites(
+        std::vector{std::move(endpoint)}, bool(TransactionRouter::get(opCtx)), targetedWrites);
+}
+
+void WriteOp::_createTargetedWrites(std::vector<ShardEndpoint> endpoints,
+                                    bool inTransaction,
+                                    std::vector<TargetedWrite*>* targetedWrites) {
     for (auto&& endpoint : endpoints) {
         // If the operation was already successfull on that shard, do not repeat it
         if (_successfulShardSet.count(endpoint.shardName))
@@ -123,6 +123,14 @@ public:
                       const NSTargeter& targeter,
                       std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as targetWrites(), but for an insert whose document has already been targeted to
+     * 'endpoint', for example as part of NSTargeter::targetInserts().
+     */
+    void targetInsertWrite(OperationContext* opCtx,
+                           ShardEndpoint endpoint,
+                           std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -161,6 +169,15 @@ public:
     void setOpError(const WriteErrorDetail& error);
 
 private:
+    /**
+     * Creates a TargetedWrite for each of 'endpoints' on which this write has not already
+     * succeeded. Outside of a transaction, writes targeting more than one endpoint are not
+     * versioned.
+     */
+    void _createTargetedWrites(std::vector<ShardEndpoint> endpoints,
+                               bool inTransaction,
+                               std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Updates the op state after new information is received.
      */
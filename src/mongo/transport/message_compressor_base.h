@@ -33,6 +33,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/base/string_data.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
 
 #include <type_traits>
 
@@ -117,6 +118,34 @@ public:
         return _decompressBytesOut.loadRelaxed();
     }
 
+    /*
+     * This returns the total time spent in compressData
+     */
+    Microseconds getCompressorTime() const {
+        return Microseconds{_compressMicros.loadRelaxed()};
+    }
+
+    /*
+     * This returns the total time spent in decompressData
+     */
+    Microseconds getDecompressorTime() const {
+        return Microseconds{_decompressMicros.loadRelaxed()};
+    }
+
+    /*
+     * Called by the MessageCompressorManager to account for time spent in compressData
+     */
+    void counterHitCompressTime(Microseconds elapsed) {
+        _compressMicros.addAndFetch(durationCount<Microseconds>(elapsed));
+    }
+
+    /*
+     * Called by the MessageCompressorManager to account for time spent in decompressData
+     */
+    void counterHitDecompressTime(Microseconds elapsed) {
+        _decompressMicros.addAndFetch(durationCount<Microseconds>(elapsed));
+    }
+
 
 protected:
     /*
@@ -151,5 +180,8 @@ private:
 
     AtomicWord<long long> _decompressBytesIn;
     AtomicWord<long long> _decompressBytesOut;
+
+    AtomicWord<long long> _compressMicros;
+    AtomicWord<long long> _decompressMicros;
 };
 }  // namespace mongo
@@ -41,6 +41,7 @@
 #include "mongo/rpc/message.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/session.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -131,7 +132,9 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
     compressionHeader.serialize(&output);
     ConstDataRange input(inputHeader.data(), inputHeader.data() + inputHeader.dataLen());
 
+    Timer timer;
     auto sws = compressor->compressData(input, output);
+    compressor->counterHitCompressTime(Microseconds{timer.micros()});
 
     if (!sws.isOK())
         return sws.getStatus();
@@ -189,7 +192,9 @@ StatusWith<Message> MessageCompressorManager::decompressMessage(const Message& m
 
     DataRangeCursor output(outMessage.data(), outMessage.data() + outMessage.dataLen());
 
+    Timer timer;
     auto sws = compressor->decompressData(input, output);
+    compressor->counterHitDecompressTime(Microseconds{timer.micros()});
 
     if (!sws.isOK())
         return sws.getStatus();
@@ -214,7 +219,19 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
         return;
 
     BSONArrayBuilder sub(output->subarrayStart("compression"));
+    const bool offerPreferredFirst =
+        !_preferredCompressor.empty() && _registry->getCompressor(_preferredCompressor);
+    if (offerPreferredFirst) {
+        LOGV2_DEBUG(7100100,
+                    3,
+                    "Offering preferred compressor to server",
+                    "compressor"_attr = _preferredCompressor);
+        sub.append(_preferredCompressor);
+    }
     for (const auto& e : _registry->getCompressorNames()) {
+        if (offerPreferredFirst && e == _preferredCompressor) {
+            continue;
+        }
         LOGV2_DEBUG(22929,
                     3,
                     "Offering {compressor} compressor to server",
@@ -225,6 +242,10 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
     sub.doneFast();
 }
 
+void MessageCompressorManager::setPreferredCompressor(StringData name) {
+    _preferredCompressor = name.toString();
+}
+
 void MessageCompressorManager::clientFinish(const BSONObj& input) {
     auto elem = input.getField("compression");
     LOGV2_DEBUG(22930, 3, "Finishing client-side compression negotiation");
@@ -33,6 +33,7 @@
 #include "mongo/transport/message_compressor_base.h"
 #include "mongo/transport/session.h"
 
+#include <string>
 #include <vector>
 
 namespace mongo {
@@ -68,6 +69,15 @@ public:
      */
     void clientBegin(BSONObjBuilder* output);
 
+    /*
+     * Sets the compressor a client should offer first during negotiation. Since the server echoes
+     * back compressors in the order the client offered them, and the first negotiated compressor
+     * is the one used by compressMessage, this lets a specific connection (for example an
+     * internal replication connection) prefer an algorithm without changing the process-wide
+     * list. Has no effect if the named compressor is not enabled in the registry.
+     */
+    void setPreferredCompressor(StringData name);
+
     /*
      * Called by a client that has received an isMaster response (received after calling
      * clientBegin) and wants to finish negotiating compression.
@@ -126,6 +136,7 @@ public:
 private:
     std::vector<MessageCompressorBase*> _negotiated;
     MessageCompressorRegistry* _registry;
+    std::string _preferredCompressor;
 };
 
 }  // namespace mongo
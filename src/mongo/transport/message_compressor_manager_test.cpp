@@ -241,6 +241,45 @@ TEST(MessageCompressorManager, FullNormalCompression) {
     clientManager.clientFinish(serverObj);
 }
 
+TEST(MessageCompressorManager, PreferredCompressorOfferedFirst) {
+    MessageCompressorRegistry registry;
+    registry.setSupportedCompressors({"noop", "zstd"});
+    registry.registerImplementation(std::make_unique<NoopMessageCompressor>());
+    registry.registerImplementation(std::make_unique<ZstdMessageCompressor>());
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+
+    MessageCompressorManager clientManager(&registry);
+    MessageCompressorManager serverManager(&registry);
+    clientManager.setPreferredCompressor("zstd");
+
+    BSONObjBuilder clientOutput;
+    clientManager.clientBegin(&clientOutput);
+    auto clientObj = clientOutput.done();
+    checkNegotiationResult(clientObj, {"zstd", "noop"});
+
+    BSONObjBuilder serverOutput;
+    serverManager.serverNegotiate(parseBSON(clientObj), &serverOutput);
+    auto serverObj = serverOutput.done();
+    checkNegotiationResult(serverObj, {"zstd", "noop"});
+    clientManager.clientFinish(serverObj);
+
+    auto swm = clientManager.compressMessage(buildMessage());
+    ASSERT_OK(swm.getStatus());
+    MessageCompressorId compressorId;
+    ASSERT_OK(serverManager.decompressMessage(swm.getValue(), &compressorId).getStatus());
+    ASSERT_EQ(compressorId, registry.getCompressor("zstd")->getId());
+}
+
+TEST(MessageCompressorManager, PreferredCompressorIgnoredWhenNotEnabled) {
+    auto registry = buildRegistry();
+    MessageCompressorManager clientManager(&registry);
+    clientManager.setPreferredCompressor("zstd");
+
+    BSONObjBuilder clientOutput;
+    clientManager.clientBegin(&clientOutput);
+    checkNegotiationResult(clientOutput.done(), {"noop"});
+}
+
 TEST(NoopMessageCompressor, Fidelity) {
     auto testMessage = buildMessage();
     checkFidelity(testMessage, std::make_unique<NoopMessageCompressor>());
@@ -273,6 +312,16 @@ TEST(ZstdMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, ReusedContextsSurviveErrors) {
+    // The zstd compressor caches its contexts per thread, so a failed call must not leave state
+    // behind that corrupts the next message compressed or decompressed on this thread.
+    auto testMessage = buildMessage();
+    for (int i = 0; i < 3; ++i) {
+        checkOverflow(std::make_unique<ZstdMessageCompressor>());
+        checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
+    }
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -36,6 +36,7 @@ namespace mongo {
 namespace {
 const auto kBytesIn = "bytesIn"_sd;
 const auto kBytesOut = "bytesOut"_sd;
+const auto kTimeMicros = "timeMicros"_sd;
 }  // namespace
 
 void appendMessageCompressionStats(BSONObjBuilder* b) {
@@ -52,12 +53,14 @@ void appendMessageCompressionStats(BSONObjBuilder* b) {
 
         BSONObjBuilder compressorSection(base.subobjStart("compressor"));
         compressorSection << kBytesIn << compressor->getCompressorBytesIn() << kBytesOut
-                          << compressor->getCompressorBytesOut();
+                          << compressor->getCompressorBytesOut() << kTimeMicros
+                          << durationCount<Microseconds>(compressor->getCompressorTime());
         compressorSection.doneFast();
 
         BSONObjBuilder decompressorSection(base.subobjStart("decompressor"));
         decompressorSection << kBytesIn << compressor->getDecompressorBytesIn() << kBytesOut
-                            << compressor->getDecompressorBytesOut();
+                            << compressor->getDecompressorBytesOut() << kTimeMicros
+                            << durationCount<Microseconds>(compressor->getDecompressorTime());
         decompressorSection.doneFast();
         base.doneFast();
     }
@@ -38,6 +38,43 @@
 #include "mongo/transport/message_compressor_zstd.h"
 
 namespace mongo {
+namespace {
+
+struct ZstdCCtxDeleter {
+    void operator()(ZSTD_CCtx* cctx) const {
+        ZSTD_freeCCtx(cctx);
+    }
+};
+
+struct ZstdDCtxDeleter {
+    void operator()(ZSTD_DCtx* dctx) const {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+/**
+ * The compressor is shared by every session, so contexts are cached per thread rather than
+ * created for each message. With synchronous ingress each connection has its own thread, which
+ * makes these effectively per-connection. A context that fails to allocate is retried on the next
+ * message, and the stateless API is used in the meantime.
+ */
+ZSTD_CCtx* getThreadCompressionContext() {
+    static thread_local std::unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> cctx;
+    if (!cctx) {
+        cctx.reset(ZSTD_createCCtx());
+    }
+    return cctx.get();
+}
+
+ZSTD_DCtx* getThreadDecompressionContext() {
+    static thread_local std::unique_ptr<ZSTD_DCtx, ZstdDCtxDeleter> dctx;
+    if (!dctx) {
+        dctx.reset(ZSTD_createDCtx());
+    }
+    return dctx.get();
+}
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +84,18 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    auto cctx = getThreadCompressionContext();
+    size_t ret = cctx ? ZSTD_compressCCtx(cctx,
+                                          const_cast<char*>(output.data()),
+                                          output.length(),
+                                          input.data(),
+                                          input.length(),
+                                          ZSTD_CLEVEL_DEFAULT)
+                      : ZSTD_compress(const_cast<char*>(output.data()),
+                                      output.length(),
+                                      input.data(),
+                                      input.length(),
+                                      ZSTD_CLEVEL_DEFAULT);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +107,16 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    auto dctx = getThreadDecompressionContext();
+    size_t ret = dctx ? ZSTD_decompressDCtx(dctx,
+                                            const_cast<char*>(output.data()),
+                                            output.length(),
+                                            input.data(),
+                                            input.length())
+                      : ZSTD_decompress(const_cast<char*>(output.data()),
+                                        output.length(),
+                                        input.data(),
+                                        input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
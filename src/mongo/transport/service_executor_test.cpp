@@ -42,6 +42,7 @@
 #include "mongo/transport/service_executor_fixed.h"
 #include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/transport/service_executor_utils.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/transport/transport_layer_mock.h"
 #include "mongo/unittest/barrier.h"
@@ -363,5 +364,28 @@ TEST_F(ServiceExecutorFixedTest, StartAndShutdownAreDeterministic) {
     });
 }
 
+TEST(ServiceExecutorUtilsTest, ParseCpuList) {
+    auto parse = [](StringData cpuList) { return uassertStatusOK(parseCpuList(cpuList)); };
+
+    ASSERT_TRUE(parse("").empty());
+    ASSERT_TRUE(parse("\n").empty());
+    ASSERT_TRUE((parse("0") == std::vector<int>{0}));
+    ASSERT_TRUE((parse("0-3\n") == std::vector<int>{0, 1, 2, 3}));
+    ASSERT_TRUE((parse("0-1,8,10-11") == std::vector<int>{0, 1, 8, 10, 11}));
+
+    for (auto invalid : {"a", "-1", "1-", "3-1", "1,,2", "1,", "1 2", "99999999"}) {
+        ASSERT_EQ(parseCpuList(invalid).getStatus(), ErrorCodes::FailedToParse) << invalid;
+    }
+}
+
+TEST(ServiceExecutorUtilsTest, ValidateServiceWorkerThreadAffinity) {
+    ASSERT_OK(validateServiceWorkerThreadAffinity("none"));
+    ASSERT_NOT_OK(validateServiceWorkerThreadAffinity("socket"));
+#if defined(__linux__)
+    ASSERT_OK(validateServiceWorkerThreadAffinity("core"));
+    ASSERT_OK(validateServiceWorkerThreadAffinity("numaNode"));
+#endif
+}
+
 }  // namespace
 }  // namespace mongo::transport
@@ -33,22 +33,32 @@
 
 #include "mongo/transport/service_executor_utils.h"
 
+#include <algorithm>
 #include <fmt/format.h>
 #include <functional>
 #include <memory>
+#include <numeric>
 
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_gen.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
 #include "mongo/util/thread_safety_context.h"
 
 #if !defined(_WIN32)
 #include <sys/resource.h>
 #endif
 
+#if defined(__linux__)
+#include <fstream>
+#include <sched.h>
+#endif
+
 #if !defined(__has_feature)
 #define __has_feature(x) 0
 #endif
@@ -58,6 +68,153 @@ using namespace fmt::literals;
 namespace mongo {
 
 namespace {
+
+constexpr auto kThreadAffinityNone = "none"_sd;
+constexpr auto kThreadAffinityCore = "core"_sd;
+constexpr auto kThreadAffinityNumaNode = "numaNode"_sd;
+
+#if defined(__linux__)
+/**
+ * The sets of CPUs that dedicated service worker threads are spread across, and the number of
+ * threads currently pinned to each of them.
+ */
+class WorkerThreadAffinity {
+public:
+    static WorkerThreadAffinity& get() {
+        static auto& affinity = *new WorkerThreadAffinity(transport::serviceExecutorThreadAffinity);
+        return affinity;
+    }
+
+    /**
+     * Pins the calling thread to the least loaded set of CPUs and returns its index, or returns
+     * boost::none if threads are not pinned.
+     */
+    boost::optional<size_t> pinCurrentThread() {
+        if (_cpuSets.empty()) {
+            return boost::none;
+        }
+
+        size_t index;
+        {
+            stdx::lock_guard lk(_mutex);
+            index = std::min_element(_numThreads.begin(), _numThreads.end()) - _numThreads.begin();
+            ++_numThreads[index];
+        }
+
+        if (int failed =
+                pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &_cpuSets[index])) {
+            LOGV2_DEBUG(7100501,
+                        1,
+                        "Failed to set the CPU affinity of a service worker thread",
+                        "error"_attr = errnoWithDescription(failed));
+        }
+
+        return index;
+    }
+
+    void unpin(size_t index) {
+        stdx::lock_guard lk(_mutex);
+        --_numThreads[index];
+    }
+
+private:
+    explicit WorkerThreadAffinity(StringData mode) {
+        if (mode == kThreadAffinityNone) {
+            return;
+        }
+
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+            LOGV2_WARNING(7100502,
+                          "Unable to get the CPU affinity of the process, service worker threads "
+                          "will not be pinned",
+                          "error"_attr = errnoWithDescription());
+            return;
+        }
+
+        // Each NUMA node's CPUs are listed together so that, in "core" mode, the least loaded CPU
+        // search spreads threads over the cores of one node before moving on to the next.
+        auto nodes = _readNodeCpus();
+        for (const auto& nodeCpus : nodes) {
+            cpu_set_t nodeSet;
+            CPU_ZERO(&nodeSet);
+            for (auto cpu : nodeCpus) {
+                if (cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed)) {
+                    continue;
+                }
+
+                if (mode == kThreadAffinityCore) {
+                    cpu_set_t coreSet;
+                    CPU_ZERO(&coreSet);
+                    CPU_SET(cpu, &coreSet);
+                    _cpuSets.push_back(coreSet);
+                } else {
+                    CPU_SET(cpu, &nodeSet);
+                }
+            }
+
+            if (mode == kThreadAffinityNumaNode && CPU_COUNT(&nodeSet) > 0) {
+                _cpuSets.push_back(nodeSet);
+            }
+        }
+
+        _numThreads.resize(_cpuSets.size());
+        LOGV2(7100503,
+              "Pinning service worker threads",
+              "mode"_attr = mode,
+              "numNodes"_attr = nodes.size(),
+              "numCpuSets"_attr = _cpuSets.size());
+    }
+
+    /**
+     * Returns the CPUs of each NUMA node, or all CPUs as a single node if the topology is not
+     * exposed through sysfs.
+     */
+    static std::vector<std::vector<int>> _readNodeCpus() {
+        auto readFile = [](const std::string& path) -> boost::optional<std::string> {
+            std::ifstream file(path);
+            std::string line;
+            if (!file || !std::getline(file, line)) {
+                return boost::none;
+            }
+            return line;
+        };
+
+        std::vector<std::vector<int>> nodes;
+        if (auto online = readFile("/sys/devices/system/node/online")) {
+            auto swNodeIds = parseCpuList(*online);
+            if (swNodeIds.isOK()) {
+                for (auto nodeId : swNodeIds.getValue()) {
+                    auto cpuList = readFile(
+                        str::stream() << "/sys/devices/system/node/node" << nodeId << "/cpulist");
+                    if (!cpuList) {
+                        continue;
+                    }
+
+                    auto swCpus = parseCpuList(*cpuList);
+                    if (swCpus.isOK() && !swCpus.getValue().empty()) {
+                        nodes.push_back(std::move(swCpus.getValue()));
+                    }
+                }
+            }
+        }
+
+        if (nodes.empty()) {
+            std::vector<int> cpus(CPU_SETSIZE);
+            std::iota(cpus.begin(), cpus.end(), 0);
+            nodes.push_back(std::move(cpus));
+        }
+
+        return nodes;
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WorkerThreadAffinity::_mutex");
+    std::vector<cpu_set_t> _cpuSets;
+    std::vector<size_t> _numThreads;
+};
+#endif
+
 void* runFunc(void* ctx) {
     auto taskPtr =
         std::unique_ptr<unique_function<void()>>(static_cast<unique_function<void()>*>(ctx));
@@ -108,6 +265,17 @@ Status launchServiceWorkerThread(unique_function<void()> task) noexcept {
         task = [sigAltStackController = std::make_shared<stdx::support::SigAltStackController>(),
                 f = std::move(task)]() mutable {
             auto sigAltStackGuard = sigAltStackController->makeInstallGuard();
+#if defined(__linux__)
+            // Pin the thread before the task runs so that the memory it allocates for the
+            // connection is first touched on the node it will keep running on.
+            auto& affinity = WorkerThreadAffinity::get();
+            auto pinnedIndex = affinity.pinCurrentThread();
+            ON_BLOCK_EXIT([&] {
+                if (pinnedIndex) {
+                    affinity.unpin(*pinnedIndex);
+                }
+            });
+#endif
             f();
         };
 
@@ -146,6 +314,83 @@ Status launchServiceWorkerThread(unique_function<void()> task) noexcept {
     return Status::OK();
 }
 
+Status validateServiceWorkerThreadAffinity(const std::string& value) {
+    if (value != kThreadAffinityNone && value != kThreadAffinityCore &&
+        value != kThreadAffinityNumaNode) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Unrecognized thread affinity '" << value << "', expected one of '"
+                              << kThreadAffinityNone << "', '" << kThreadAffinityCore << "' or '"
+                              << kThreadAffinityNumaNode << "'"};
+    }
+
+#if !defined(__linux__)
+    if (value != kThreadAffinityNone) {
+        return {ErrorCodes::InvalidOptions,
+                "Pinning service worker threads is only supported on Linux"};
+    }
+#endif
+
+    return Status::OK();
+}
+
+StatusWith<std::vector<int>> parseCpuList(StringData cpuList) {
+    // Larger numbers than this cannot be CPUs or NUMA nodes.
+    constexpr int kMaxNumber = 1 << 16;
+
+    auto badValue = [&] {
+        return Status(ErrorCodes::FailedToParse,
+                      str::stream() << "Invalid CPU list '" << cpuList << "'");
+    };
+
+    std::vector<int> cpus;
+    size_t pos = 0;
+    auto parseNumber = [&]() -> boost::optional<int> {
+        if (pos == cpuList.size() || !ctype::isDigit(cpuList[pos])) {
+            return boost::none;
+        }
+
+        int value = 0;
+        for (; pos < cpuList.size() && ctype::isDigit(cpuList[pos]); ++pos) {
+            value = value * 10 + (cpuList[pos] - '0');
+            if (value > kMaxNumber) {
+                return boost::none;
+            }
+        }
+        return value;
+    };
+
+    while (!cpuList.empty() && ctype::isSpace(cpuList[cpuList.size() - 1])) {
+        cpuList = cpuList.substr(0, cpuList.size() - 1);
+    }
+
+    while (pos < cpuList.size()) {
+        auto first = parseNumber();
+        auto last = first;
+        if (first && pos < cpuList.size() && cpuList[pos] == '-') {
+            ++pos;
+            last = parseNumber();
+        }
+
+        if (!first || !last || *last < *first) {
+            return badValue();
+        }
+
+        if (pos < cpuList.size()) {
+            // Ranges are separated by a single comma, with no trailing comma.
+            if (cpuList[pos] != ',' || pos + 1 == cpuList.size()) {
+                return badValue();
+            }
+            ++pos;
+        }
+
+        for (int cpu = *first; cpu <= *last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
 void scheduleCallbackOnDataAvailable(const transport::SessionHandle& session,
                                      unique_function<void(Status)> callback,
                                      transport::ServiceExecutor* executor) noexcept {
@@ -30,7 +30,11 @@
 #pragma once
 
 #include <functional>
+#include <string>
+#include <vector>
 
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/functional.h"
 
@@ -40,8 +44,23 @@ namespace transport {
 class ServiceExecutor;
 }
 
+/**
+ * Runs 'task' on a new detached thread. The thread is pinned to CPUs according to the
+ * serviceExecutorThreadAffinity server parameter.
+ */
 Status launchServiceWorkerThread(unique_function<void()> task) noexcept;
 
+/**
+ * Validates the serviceExecutorThreadAffinity server parameter.
+ */
+Status validateServiceWorkerThreadAffinity(const std::string& value);
+
+/**
+ * Parses a list of CPU or NUMA node numbers in the format of the Linux sysfs "cpulist" files, such
+ * as "0-3,8,10-11".
+ */
+StatusWith<std::vector<int>> parseCpuList(StringData cpuList);
+
 /* The default implementation for "ServiceExecutor::runOnDataAvailable()", which blocks the caller
  * thread until data is available for reading. On success, it schedules "callback" on "executor".
  * Other implementations (e.g., "ServiceExecutorFixed") may provide asynchronous variants.
@@ -33,6 +33,7 @@
 
 #include "mongo/config.h"
 #include "mongo/logv2/log.h"
+#include "mongo/transport/transport_options_gen.h"
 
 namespace mongo::transport {
 
@@ -40,6 +41,27 @@ MONGO_FAIL_POINT_DEFINE(transportLayerASIOshortOpportunisticReadWrite);
 
 namespace {
 
+constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+Status validateMessageLength(size_t msgLen) {
+    if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+        StringBuilder sb;
+        sb << "recv(): message msgLen " << msgLen << " is invalid. "
+           << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+        const auto str = sb.str();
+        LOGV2(4615638,
+              "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
+              "recv(): message mstLen is invalid.",
+              "msgLen"_attr = msgLen,
+              "min"_attr = kHeaderSize,
+              "max"_attr = MaxMessageSizeBytes);
+
+        return Status(ErrorCodes::ProtocolError, str);
+    }
+
+    return Status::OK();
+}
+
 template <int Name>
 class ASIOSocketTimeoutOption {
 public:
@@ -165,6 +187,10 @@ Future<Message> TransportLayerASIO::ASIOSession::asyncSourceMessage(
 
 Status TransportLayerASIO::ASIOSession::waitForData() noexcept try {
     ensureSync();
+    if (readAheadBytesBuffered()) {
+        return Status::OK();
+    }
+
     asio::error_code ec;
     getSocket().wait(asio::ip::tcp::socket::wait_read, ec);
     return errorCodeToStatus(ec);
@@ -174,6 +200,10 @@ Status TransportLayerASIO::ASIOSession::waitForData() noexcept try {
 
 Future<void> TransportLayerASIO::ASIOSession::asyncWaitForData() noexcept try {
     ensureAsync();
+    if (readAheadBytesBuffered()) {
+        return Future<void>::makeReady();
+    }
+
     return getSocket().async_wait(asio::ip::tcp::socket::wait_read, UseFuture{});
 } catch (const DBException& ex) {
     return ex.toStatus();
@@ -285,6 +315,10 @@ Future<void> TransportLayerASIO::ASIOSession::handshakeSSLForEgressWithLock(
     _sslSocket.emplace(std::move(_socket), *_sslContext->egress, removeFQDNRoot(target.host()));
     lk.unlock();
 
+    if (_sslContext->manager) {
+        _sslContext->manager->prepareEgressHandshake(_sslSocket->native_handle(), target);
+    }
+
     auto doHandshake = [&] {
         if (_blockingMode == Sync) {
             std::error_code ec;
@@ -366,7 +400,9 @@ auto TransportLayerASIO::ASIOSession::getSocket() -> GenericSocket& {
 }
 
 Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHandle& baton) {
-    static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+    if (readAheadBytesBuffered() || shouldReadAhead()) {
+        return sourceMessageWithReadAhead(baton);
+    }
 
     auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
     auto ptr = headerBuffer.get();
@@ -377,19 +413,8 @@ Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHa
             }
 
             const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
-            if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-                StringBuilder sb;
-                sb << "recv(): message msgLen " << msgLen << " is invalid. "
-                   << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-                const auto str = sb.str();
-                LOGV2(4615638,
-                      "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
-                      "recv(): message mstLen is invalid.",
-                      "msgLen"_attr = msgLen,
-                      "min"_attr = kHeaderSize,
-                      "max"_attr = MaxMessageSizeBytes);
-
-                return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+            if (auto status = validateMessageLength(msgLen); !status.isOK()) {
+                return Future<Message>::makeReady(std::move(status));
             }
 
             if (msgLen == kHeaderSize) {
@@ -414,6 +439,122 @@ Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHa
         });
 }
 
+bool TransportLayerASIO::ASIOSession::shouldReadAhead() const {
+#ifdef MONGO_CONFIG_SSL
+    // The first bytes on an ingress session must be read exactly so that a TLS client hello can be
+    // handed to the SSL stream, see maybeHandshakeSSLForIngress().
+    if (!_ranHandshake) {
+        return false;
+    }
+#endif
+    return _isIngressSession && _blockingMode == Sync && gIngressReadAheadBufferSizeBytes > 0;
+}
+
+Future<Message> TransportLayerASIO::ASIOSession::sourceMessageWithReadAhead(
+    const BatonHandle& baton) {
+    auto buffered = readAheadBytesBuffered();
+    if (buffered < kHeaderSize) {
+        // Move any partial header to the front of a new buffer and fill the rest of it with
+        // whatever the socket has available, which will usually include the entire message.
+        const auto bufferSize = std::max(size_t(gIngressReadAheadBufferSizeBytes), kHeaderSize);
+        auto buffer = SharedBuffer::allocate(bufferSize);
+        if (buffered) {
+            memcpy(buffer.get(), _readAheadBuffer.get() + _readAheadBegin, buffered);
+        }
+
+        _readAheadBuffer = std::move(buffer);
+        _readAheadBegin = 0;
+        _readAheadEnd = buffered;
+
+        // Bytes which arrived before an error, such as a timeout, are kept for the next attempt.
+        size_t bytesRead = 0;
+        auto status = readAtLeast(
+            asio::buffer(_readAheadBuffer.get() + buffered, bufferSize - buffered),
+            kHeaderSize - buffered,
+            &bytesRead);
+        _readAheadEnd += bytesRead;
+        if (!status.isOK()) {
+            return status;
+        }
+
+        buffered = _readAheadEnd;
+    }
+
+    const char* const data = _readAheadBuffer.get() + _readAheadBegin;
+    if (checkForHTTPRequest(asio::buffer(data, kHeaderSize))) {
+        return sendHTTPResponse(baton);
+    }
+
+    const auto msgLen = size_t(MSGHEADER::ConstView(data).getMessageLength());
+    if (auto status = validateMessageLength(msgLen); !status.isOK()) {
+        return status;
+    }
+
+    auto buffer = SharedBuffer::allocate(msgLen);
+    const auto fromReadAhead = std::min(msgLen, buffered);
+    memcpy(buffer.get(), data, fromReadAhead);
+
+    _readAheadBegin += fromReadAhead;
+    if (_readAheadBegin == _readAheadEnd) {
+        _readAheadBuffer = {};
+        _readAheadBegin = _readAheadEnd = 0;
+    }
+
+    auto makeMessage = [this, msgLen](SharedBuffer buffer) {
+        if (_isIngressSession) {
+            networkCounter.hitPhysicalIn(msgLen);
+        }
+        return Message(std::move(buffer));
+    };
+
+    if (fromReadAhead == msgLen) {
+        return makeMessage(std::move(buffer));
+    }
+
+    // The rest of a message larger than the read ahead buffer is read directly into the message.
+    auto remaining = asio::buffer(buffer.get() + fromReadAhead, msgLen - fromReadAhead);
+    return read(remaining, baton).then(
+        [buffer = std::move(buffer), makeMessage = std::move(makeMessage)]() mutable {
+            return makeMessage(std::move(buffer));
+        });
+}
+
+Status TransportLayerASIO::ASIOSession::readAtLeast(asio::mutable_buffer buffer,
+                                                    size_t minBytes,
+                                                    size_t* bytesRead) {
+#ifdef MONGO_CONFIG_SSL
+    if (_sslSocket) {
+        return readAtLeast(*_sslSocket, buffer, minBytes, bytesRead);
+    }
+#endif
+    return readAtLeast(_socket, buffer, minBytes, bytesRead);
+}
+
+template <typename Stream>
+Status TransportLayerASIO::ASIOSession::readAtLeast(Stream& stream,
+                                                    asio::mutable_buffer buffer,
+                                                    size_t minBytes,
+                                                    size_t* bytesRead) {
+    invariant(_blockingMode == Sync);
+
+    while (*bytesRead < minBytes) {
+        std::error_code ec;
+        *bytesRead += asio::read(stream,
+                                 buffer + *bytesRead,
+                                 asio::transfer_at_least(minBytes - *bytesRead),
+                                 ec);
+        if (ec == asio::error::interrupted) {
+            continue;  // retry syscall EINTR
+        }
+
+        if (ec) {
+            return errorCodeToStatus(ec);
+        }
+    }
+
+    return Status::OK();
+}
+
 template <typename MutableBufferSequence>
 Future<void> TransportLayerASIO::ASIOSession::read(const MutableBufferSequence& buffers,
                                                    const BatonHandle& baton) {
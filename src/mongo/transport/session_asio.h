@@ -40,6 +40,7 @@
 #include "mongo/transport/transport_layer_asio.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
+#include "mongo/util/shared_buffer.h"
 #ifdef MONGO_CONFIG_SSL
 #include "mongo/util/net/ssl_manager.h"
 #include "mongo/util/net/ssl_peer_info.h"
@@ -165,6 +166,31 @@ private:
 
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr);
 
+    /**
+     * Sources a message through '_readAheadBuffer', filling it with as many bytes as the socket
+     * has available whenever it holds less than a complete header. Only used by synchronous
+     * ingress sessions once the first message has determined whether the session uses TLS.
+     */
+    Future<Message> sourceMessageWithReadAhead(const BatonHandle& baton = nullptr);
+
+    bool shouldReadAhead() const;
+
+    size_t readAheadBytesBuffered() const {
+        return _readAheadEnd - _readAheadBegin;
+    }
+
+    /**
+     * Reads at least 'minBytes' into 'buffer' on a blocking socket. 'bytesRead' is set to the
+     * number of bytes read even if an error is returned.
+     */
+    Status readAtLeast(asio::mutable_buffer buffer, size_t minBytes, size_t* bytesRead);
+
+    template <typename Stream>
+    Status readAtLeast(Stream& stream,
+                       asio::mutable_buffer buffer,
+                       size_t minBytes,
+                       size_t* bytesRead);
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers, const BatonHandle& baton = nullptr);
 
@@ -252,6 +278,12 @@ private:
     std::shared_ptr<const SSLConnectionContext> _sslContext;
 #endif
 
+    // Bytes received but not yet consumed by sourceMessage() are held in
+    // _readAheadBuffer[_readAheadBegin, _readAheadEnd). The buffer is released once it is drained.
+    SharedBuffer _readAheadBuffer;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
+
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
 };
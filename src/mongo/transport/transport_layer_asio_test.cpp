@@ -272,16 +272,24 @@ public:
         }
     }
 
-    void sendMessage() {
+    static Message makeMessage(int value = 1) {
         OpMsgBuilder builder;
-        builder.setBody(BSON("ping" << 1));
+        builder.setBody(BSON("ping" << value));
         Message msg = builder.finish();
         msg.header().setResponseToMsgId(0);
         msg.header().setId(0);
         OpMsg::appendChecksum(&msg);
+        return msg;
+    }
+
+    void sendMessage() {
+        auto msg = makeMessage();
+        sendBytes(msg.buf(), msg.size());
+    }
 
+    void sendBytes(const char* data, size_t size) {
         std::error_code ec;
-        asio::write(_sock, asio::buffer(msg.buf(), msg.size()), ec);
+        asio::write(_sock, asio::buffer(data, size), ec);
         ASSERT_FALSE(ec);
     }
 
@@ -382,5 +390,57 @@ TEST(TransportLayerASIO, SwitchTimeoutModes) {
     tla->shutdown();
 }
 
+/* check that messages which arrive together, or split at any point, are sourced in order */
+class PipelinedSEP : public TimeoutSEP {
+public:
+    explicit PipelinedSEP(int numMessages) : _numMessages(numMessages) {}
+
+    void startSession(transport::SessionHandle session) override {
+        LOGV2(7100500, "Accepted connection", "remote"_attr = session->remote());
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            for (int i = 0; i < _numMessages; ++i) {
+                ASSERT_OK(session->waitForData());
+                auto swMessage = session->sourceMessage();
+                ASSERT_OK(swMessage.getStatus());
+                auto request = OpMsg::parse(swMessage.getValue());
+                ASSERT_BSONOBJ_EQ(request.body, BSON("ping" << i));
+            }
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+
+private:
+    const int _numMessages;
+};
+
+TEST(TransportLayerASIO, SourcePipelinedMessages) {
+    constexpr int kNumMessages = 6;
+    PipelinedSEP sep(kNumMessages);
+    auto tla = makeAndStartTL(&sep);
+
+    TimeoutConnector connector(tla->listenerPort(), false);
+
+    // The first message is sent on its own since it determines whether the session uses TLS.
+    auto first = TimeoutConnector::makeMessage(0);
+    connector.sendBytes(first.buf(), first.size());
+
+    std::string pipelined;
+    for (int i = 1; i < kNumMessages; ++i) {
+        auto msg = TimeoutConnector::makeMessage(i);
+        pipelined.append(msg.buf(), msg.size());
+    }
+
+    // Split the remaining messages in the middle of a header.
+    const size_t split = first.size() + 7;
+    connector.sendBytes(pipelined.data(), split);
+    sleepmillis(100);
+    connector.sendBytes(pipelined.data() + split, pipelined.size() - split);
+
+    ASSERT_TRUE(sep.waitForTimeout(Milliseconds{10000}));
+    tla->shutdown();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,53 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <ostream>
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * The queue an operation joins when it has to wait for a ticket. Waiters in the normal queue are
+ * always admitted before waiters in the low priority queue, and each queue admits its waiters in
+ * arrival order. Operations only queue when no ticket is free, so an idle system admits low
+ * priority work just as quickly as normal work.
+ */
+enum class AdmissionPriority { kNormal = 0, kLow = 1 };
+
+StringData toString(AdmissionPriority priority);
+
+inline std::ostream& operator<<(std::ostream& os, AdmissionPriority priority) {
+    return os << toString(priority);
+}
+
+}  // namespace mongo
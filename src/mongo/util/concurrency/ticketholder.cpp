@@ -33,13 +33,176 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
+StringData toString(AdmissionPriority priority) {
+    switch (priority) {
+        case AdmissionPriority::kNormal:
+            return "normal"_sd;
+        case AdmissionPriority::kLow:
+            return "low"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+const std::array<int64_t, TicketHolder::kNumQueueLatencyBuckets>
+    TicketHolder::kQueueLatencyLowerBounds = {0, 100, 1000, 10000, 100000, 1000000, 10000000};
+
+void TicketHolder::waitForTicket(OperationContext* opCtx, AdmissionPriority priority) {
+    waitForTicketUntil(opCtx, Date_t::max(), priority);
+}
+
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                      Date_t until,
+                                      AdmissionPriority priority) {
+    return _waitForTicketUntil(opCtx, until, priority, true);
+}
+
+bool TicketHolder::_waitForTicketUntil(OperationContext* opCtx,
+                                       Date_t until,
+                                       AdmissionPriority priority,
+                                       bool counted) {
+    // Attempt to get a ticket without queueing when nobody is waiting ahead of us.
+    if (_numQueued.load() == 0 && tryAcquire()) {
+        return true;
+    }
+
+    Waiter waiter(priority, counted);
+    stdx::unique_lock<Latch> lk(_queueMutex);
+    auto& queue = _queues[static_cast<size_t>(priority)];
+    waiter.position = queue.insert(queue.end(), &waiter);
+    _numQueued.addAndFetch(1);
+    if (counted) {
+        ++_queueStats[static_cast<size_t>(priority)].queued;
+        _totalQueued.fetchAndAddRelaxed(1);
+    }
+
+    // A ticket released before we were counted in '_numQueued' went back to the pool rather than
+    // to a waiter, so hand out whatever is free now that we are in line.
+    _grantToQueued(lk);
+
+    auto isGranted = [&] { return waiter.granted; };
+    bool granted = false;
+    try {
+        if (opCtx) {
+            granted =
+                opCtx->waitForConditionOrInterruptUntil(waiter.grantedCV, lk, until, isGranted);
+        } else if (until == Date_t::max()) {
+            waiter.grantedCV.wait(lk, isGranted);
+            granted = true;
+        } else {
+            granted = waiter.grantedCV.wait_until(lk, until.toSystemTimePoint(), isGranted);
+        }
+    } catch (...) {
+        if (waiter.granted) {
+            // The ticket was handed to us just before the interruption was noticed.
+            lk.unlock();
+            release();
+        } else {
+            _dequeue(lk, &waiter, false);
+        }
+        throw;
+    }
+
+    if (!granted) {
+        _dequeue(lk, &waiter, false);
+    }
+    return granted;
+}
+
+void TicketHolder::release() {
+    _totalReleased.fetchAndAddRelaxed(1);
+    _releaseImpl();
+    if (_numQueued.load() > 0) {
+        stdx::lock_guard<Latch> lk(_queueMutex);
+        _grantToQueued(lk);
+    }
+}
+
+void TicketHolder::_grantToQueued(WithLock lk) {
+    for (auto& queue : _queues) {
+        while (!queue.empty()) {
+            if (!tryAcquire()) {
+                return;
+            }
+            auto waiter = queue.front();
+            _dequeue(lk, waiter, true);
+            waiter->granted = true;
+            waiter->grantedCV.notify_one();
+        }
+    }
+}
+
+void TicketHolder::_dequeue(WithLock, Waiter* waiter, bool admitted) {
+    _queues[static_cast<size_t>(waiter->priority)].erase(waiter->position);
+    _numQueued.subtractAndFetch(1);
+    if (!waiter->counted) {
+        return;
+    }
+
+    auto& stats = _queueStats[static_cast<size_t>(waiter->priority)];
+    --stats.queued;
+    if (!admitted) {
+        ++stats.abandoned;
+        return;
+    }
+
+    const auto micros = waiter->queuedFor.micros();
+    const auto bucket = std::upper_bound(kQueueLatencyLowerBounds.begin(),
+                                         kQueueLatencyLowerBounds.end(),
+                                         micros) -
+        kQueueLatencyLowerBounds.begin() - 1;
+    ++stats.ops;
+    stats.totalMicros += micros;
+    ++stats.buckets[bucket];
+}
+
+int TicketHolder::queued(AdmissionPriority priority) const {
+    stdx::lock_guard<Latch> lk(_queueMutex);
+    return _queueStats[static_cast<size_t>(priority)].queued;
+}
+
+void TicketHolder::appendStats(BSONObjBuilder* b) const {
+    b->append("out", used());
+    b->append("available", available());
+    b->append("totalTickets", outof());
+
+    BSONObjBuilder queuesBuilder(b->subobjStart("queues"));
+    stdx::lock_guard<Latch> lk(_queueMutex);
+    for (size_t i = 0; i < kNumPriorities; ++i) {
+        const auto& stats = _queueStats[i];
+        BSONObjBuilder queueBuilder(
+            queuesBuilder.subobjStart(toString(static_cast<AdmissionPriority>(i))));
+        queueBuilder.append("queued", stats.queued);
+        queueBuilder.append("abandoned", stats.abandoned);
+
+        // Only non-empty buckets are reported to keep FTDC samples small.
+        BSONArrayBuilder histogramBuilder(queueBuilder.subarrayStart("histogram"));
+        for (size_t bucket = 0; bucket < kNumQueueLatencyBuckets; ++bucket) {
+            if (stats.buckets[bucket] == 0) {
+                continue;
+            }
+            BSONObjBuilder entryBuilder(histogramBuilder.subobjStart());
+            entryBuilder.append("micros", static_cast<long long>(kQueueLatencyLowerBounds[bucket]));
+            entryBuilder.append("count", stats.buckets[bucket]);
+            entryBuilder.doneFast();
+        }
+        histogramBuilder.doneFast();
+
+        queueBuilder.append("latency", stats.totalMicros);
+        queueBuilder.append("ops", stats.ops);
+        queueBuilder.doneFast();
+    }
+    queuesBuilder.doneFast();
+}
+
 #if defined(__linux__)
 namespace {
 
@@ -61,14 +224,6 @@ void check(int ret) {
         return;
     failWithErrno(errno);
 }
-
-/**
- * Takes a Date_t deadline and sets the appropriate values in a timespec structure.
- */
-void tsFromDate(const Date_t& deadline, struct timespec& ts) {
-    ts.tv_sec = deadline.toTimeT();
-    ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
-}
 }  // namespace
 
 TicketHolder::TicketHolder(int num) : _outof(num) {
@@ -89,47 +244,7 @@ bool TicketHolder::tryAcquire() {
     return true;
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
-    if (sem_trywait(&_sem) == 0) {
-        return true;
-    }
-
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
-        }
-
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
-    }
-    return true;
-}
-
-void TicketHolder::release() {
+void TicketHolder::_releaseImpl() {
     check(sem_post(&_sem));
 }
 
@@ -145,13 +260,22 @@ Status TicketHolder::resize(int newSize) {
                       str::stream() << "Maximum value for semaphore is " << SEM_VALUE_MAX
                                     << "; given " << newSize);
 
-    while (_outof.load() < newSize) {
-        release();
-        _outof.fetchAndAdd(1);
+    if (_outof.load() < newSize) {
+        // Added tickets are not work finishing, so they are not counted in '_totalReleased'.
+        while (_outof.load() < newSize) {
+            _releaseImpl();
+            _outof.fetchAndAdd(1);
+        }
+
+        // Any tickets added by growing belong to the operations already waiting for one.
+        stdx::lock_guard<Latch> queueLk(_queueMutex);
+        _grantToQueued(queueLk);
     }
 
+    // Taking tickets out of circulation is not demand for them, so it must not look like queueing
+    // to anyone sizing the pool from 'totalQueued'.
     while (_outof.load() > newSize) {
-        waitForTicket();
+        _waitForTicketUntil(nullptr, Date_t::max(), AdmissionPriority::kNormal, false);
         _outof.subtractAndFetch(1);
     }
 
@@ -184,55 +308,33 @@ bool TicketHolder::tryAcquire() {
     return _tryAcquire();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
-    }
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
-    } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
-    }
+void TicketHolder::_releaseImpl() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _num++;
 }
 
-void TicketHolder::release() {
+Status TicketHolder::resize(int newSize) {
     {
         stdx::lock_guard<Latch> lk(_mutex);
-        _num++;
-    }
-    _newTicket.notify_one();
-}
 
-Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_mutex);
+        int used = _outof.load() - _num;
+        if (used > newSize) {
+            std::stringstream ss;
+            ss << "can't resize since we're using (" << used << ") "
+               << "more than newSize(" << newSize << ")";
 
-    int used = _outof.load() - _num;
-    if (used > newSize) {
-        std::stringstream ss;
-        ss << "can't resize since we're using (" << used << ") "
-           << "more than newSize(" << newSize << ")";
+            std::string errmsg = ss.str();
+            LOGV2(23120, "{errmsg}", "errmsg"_attr = errmsg);
+            return Status(ErrorCodes::BadValue, errmsg);
+        }
 
-        std::string errmsg = ss.str();
-        LOGV2(23120, "{errmsg}", "errmsg"_attr = errmsg);
-        return Status(ErrorCodes::BadValue, errmsg);
+        _outof.store(newSize);
+        _num = _outof.load() - used;
     }
 
-    _outof.store(newSize);
-    _num = _outof.load() - used;
-
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
+    // Any tickets added by growing belong to the operations already waiting for one.
+    stdx::lock_guard<Latch> lk(_queueMutex);
+    _grantToQueued(lk);
     return Status::OK();
 }
 
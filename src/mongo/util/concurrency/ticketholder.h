@@ -32,15 +32,23 @@
 #include <semaphore.h>
 #endif
 
+#include <array>
+#include <list>
+
 #include "mongo/db/operation_context.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/admission_priority.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
+
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
@@ -55,8 +63,10 @@ public:
      * Attempts to acquire a ticket. Blocks until a ticket is acquired or the OperationContext
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
+     * If no ticket is free, the caller waits in the queue for 'priority'.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx,
+                       AdmissionPriority priority = AdmissionPriority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -67,8 +77,11 @@ public:
      * AssertionException if the OperationContext 'opCtx' is killed and no waits for tickets can
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
+     * If no ticket is free, the caller waits in the queue for 'priority'.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            AdmissionPriority priority = AdmissionPriority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -82,7 +95,101 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of operations currently waiting in the queue for 'priority'.
+     */
+    int queued(AdmissionPriority priority) const;
+
+    /**
+     * Returns the number of tickets released since construction. The rate at which this grows is
+     * the rate at which ticket holders finish their work.
+     */
+    long long totalReleased() const {
+        return _totalReleased.loadRelaxed();
+    }
+
+    /**
+     * Returns the number of times since construction that an operation had to queue because no
+     * ticket was free.
+     */
+    long long totalQueued() const {
+        return _totalQueued.loadRelaxed();
+    }
+
+    /**
+     * Appends the ticket counts and, for each priority, the queue length along with a histogram of
+     * the time spent queued by operations that had to wait.
+     */
+    void appendStats(BSONObjBuilder* b) const;
+
+    static constexpr size_t kNumPriorities = 2;
+
+    // Inclusive lower bounds, in microseconds, of the queueing latency histogram buckets.
+    static constexpr size_t kNumQueueLatencyBuckets = 7;
+    static const std::array<int64_t, kNumQueueLatencyBuckets> kQueueLatencyLowerBounds;
+
 private:
+    /**
+     * A thread that found no free ticket. Released tickets are handed directly to the waiter at
+     * the front of the highest priority non-empty queue, so later arrivals and lower priorities
+     * cannot overtake it.
+     */
+    struct Waiter {
+        Waiter(AdmissionPriority p, bool counted) : priority(p), counted(counted) {}
+
+        const AdmissionPriority priority;
+        // Whether the wait is reported in the queue statistics and 'totalQueued'. Tickets taken to
+        // shrink the pool are not, since no operation is held up by them.
+        const bool counted;
+        std::list<Waiter*>::iterator position;
+        Timer queuedFor;
+        bool granted = false;
+        stdx::condition_variable grantedCV;
+    };
+
+    struct QueueStats {
+        int queued = 0;
+        long long ops = 0;
+        long long abandoned = 0;
+        long long totalMicros = 0;
+        std::array<long long, kNumQueueLatencyBuckets> buckets{};
+    };
+
+    /**
+     * Implements 'waitForTicketUntil', only reporting the wait in the queue statistics when
+     * 'counted' is true.
+     */
+    bool _waitForTicketUntil(OperationContext* opCtx,
+                             Date_t until,
+                             AdmissionPriority priority,
+                             bool counted);
+
+    /**
+     * Returns a ticket to the underlying pool without regard to the queues.
+     */
+    void _releaseImpl();
+
+    /**
+     * Hands free tickets to queued waiters in priority order until either runs out.
+     */
+    void _grantToQueued(WithLock);
+
+    /**
+     * Removes 'waiter' from its queue, recording whether it was admitted or gave up.
+     */
+    void _dequeue(WithLock, Waiter* waiter, bool admitted);
+
+    mutable Mutex _queueMutex = MONGO_MAKE_LATCH("TicketHolder::_queueMutex");
+    std::array<std::list<Waiter*>, kNumPriorities> _queues;
+    std::array<QueueStats, kNumPriorities> _queueStats;
+
+    // Read without '_queueMutex' so that acquiring and releasing can skip the queues when nobody
+    // is waiting.
+    AtomicWord<int> _numQueued{0};
+
+    AtomicWord<long long> _totalReleased{0};
+    AtomicWord<long long> _totalQueued{0};
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
@@ -96,7 +203,6 @@ private:
     AtomicWord<int> _outof;
     int _num;
     Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
-    stdx::condition_variable _newTicket;
 #endif
 };
 
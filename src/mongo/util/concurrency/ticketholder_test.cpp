@@ -32,8 +32,12 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
 
 namespace {
 using namespace mongo;
@@ -72,4 +76,146 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+void waitForQueued(const TicketHolder& holder, AdmissionPriority priority, int expected) {
+    while (holder.queued(priority) != expected) {
+        sleepmillis(1);
+    }
+}
+
+/**
+ * Starts a thread that waits for a ticket from 'holder' in the queue for 'priority', appends 'name'
+ * to 'order' once admitted and then gives the ticket back.
+ */
+stdx::thread startWaiter(TicketHolder* holder,
+                         AdmissionPriority priority,
+                         std::string name,
+                         Mutex* mutex,
+                         std::vector<std::string>* order) {
+    return stdx::thread([=] {
+        holder->waitForTicket(nullptr, priority);
+        {
+            stdx::lock_guard<Latch> lk(*mutex);
+            order->push_back(name);
+        }
+        holder->release();
+    });
+}
+
+TEST(TicketholderTest, NormalPriorityAdmittedBeforeLowPriority) {
+    TicketHolder holder(1);
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> order;
+
+    ASSERT(holder.tryAcquire());
+    auto low = startWaiter(&holder, AdmissionPriority::kLow, "low", &mutex, &order);
+    waitForQueued(holder, AdmissionPriority::kLow, 1);
+    auto normal = startWaiter(&holder, AdmissionPriority::kNormal, "normal", &mutex, &order);
+    waitForQueued(holder, AdmissionPriority::kNormal, 1);
+
+    holder.release();
+    normal.join();
+    low.join();
+
+    ASSERT_TRUE((order == std::vector<std::string>{"normal", "low"}));
+    ASSERT_EQ(holder.used(), 0);
+}
+
+TEST(TicketholderTest, WaitersWithTheSamePriorityAreAdmittedInArrivalOrder) {
+    TicketHolder holder(1);
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> order;
+    std::vector<std::string> expected;
+    std::vector<stdx::thread> threads;
+
+    ASSERT(holder.tryAcquire());
+    for (int i = 0; i < 5; ++i) {
+        auto name = std::to_string(i);
+        threads.push_back(startWaiter(&holder, AdmissionPriority::kNormal, name, &mutex, &order));
+        waitForQueued(holder, AdmissionPriority::kNormal, i + 1);
+        expected.push_back(name);
+    }
+
+    holder.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_TRUE((order == expected));
+    ASSERT_EQ(holder.used(), 0);
+}
+
+TEST(TicketholderTest, QueuedWaiterTimesOutWithoutTicket) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+    ASSERT_FALSE(holder.waitForTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(5), AdmissionPriority::kLow));
+    ASSERT_EQ(holder.queued(AdmissionPriority::kLow), 0);
+
+    // The ticket goes back to the pool since nobody is left waiting for it.
+    holder.release();
+    ASSERT_EQ(holder.available(), 1);
+
+    BSONObjBuilder builder;
+    holder.appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["queues"]["low"]["abandoned"].numberLong(), 1);
+    ASSERT_EQ(stats["queues"]["low"]["ops"].numberLong(), 0);
+}
+
+TEST(TicketholderTest, StatsReportQueueingLatency) {
+    TicketHolder holder(1);
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> order;
+
+    ASSERT(holder.tryAcquire());
+    auto waiter = startWaiter(&holder, AdmissionPriority::kNormal, "normal", &mutex, &order);
+    waitForQueued(holder, AdmissionPriority::kNormal, 1);
+    sleepmillis(2);
+    holder.release();
+    waiter.join();
+
+    BSONObjBuilder builder;
+    holder.appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["totalTickets"].numberInt(), 1);
+    ASSERT_EQ(stats["available"].numberInt(), 1);
+
+    auto normal = stats["queues"]["normal"].Obj();
+    ASSERT_EQ(normal["queued"].numberInt(), 0);
+    ASSERT_EQ(normal["ops"].numberLong(), 1);
+    ASSERT_GTE(normal["latency"].numberLong(), 2000);
+
+    auto histogram = normal["histogram"].Array();
+    ASSERT_EQ(histogram.size(), 1u);
+    ASSERT_GTE(histogram[0]["micros"].numberLong(), 1000);
+    ASSERT_EQ(histogram[0]["count"].numberLong(), 1);
+
+    ASSERT_EQ(stats["queues"]["low"]["ops"].numberLong(), 0);
+}
+
+#if defined(__linux__)
+TEST(TicketholderTest, ShrinkingIsNotCountedAsQueueing) {
+    TicketHolder holder(6);
+    for (int i = 0; i < 6; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+
+    // Shrinking has to wait for a ticket to be released.
+    auto resizer = stdx::thread([&] { ASSERT_OK(holder.resize(5)); });
+    sleepmillis(2);
+    holder.release();
+    resizer.join();
+
+    ASSERT_EQ(holder.outof(), 5);
+    ASSERT_EQ(holder.used(), 5);
+    ASSERT_EQ(holder.totalQueued(), 0);
+
+    BSONObjBuilder builder;
+    holder.appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["queues"]["normal"]["queued"].numberInt(), 0);
+    ASSERT_EQ(stats["queues"]["normal"]["ops"].numberLong(), 0);
+}
+#endif
 }  // namespace
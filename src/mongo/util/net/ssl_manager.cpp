@@ -271,6 +271,8 @@ std::pair<std::string, RFC4514Parser::ValueTerminator> RFC4514Parser::extractVal
 }
 
 const auto getTLSVersionCounts = ServiceContext::declareDecoration<TLSVersionCounts>();
+const auto getTLSSessionResumptionCounts =
+    ServiceContext::declareDecoration<TLSSessionResumptionCounts>();
 
 
 void canonicalizeClusterDN(std::vector<std::string>* dn) {
@@ -612,6 +614,10 @@ TLSVersionCounts& TLSVersionCounts::get(ServiceContext* serviceContext) {
     return getTLSVersionCounts(serviceContext);
 }
 
+TLSSessionResumptionCounts& TLSSessionResumptionCounts::get(ServiceContext* serviceContext) {
+    return getTLSSessionResumptionCounts(serviceContext);
+}
+
 MONGO_INITIALIZER_WITH_PREREQUISITES(SSLManagerLogger, ("SSLManager"))
 (InitializerContext*) {
     if (!isSSLServer || (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled)) {
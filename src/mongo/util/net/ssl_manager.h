@@ -164,6 +164,17 @@ struct TLSVersionCounts {
     static TLSVersionCounts& get(ServiceContext* serviceContext);
 };
 
+/**
+ * Counts of TLS handshakes which resumed a previously negotiated session rather than performing a
+ * full handshake.
+ */
+struct TLSSessionResumptionCounts {
+    AtomicWord<long long> ingress;
+    AtomicWord<long long> egress;
+
+    static TLSSessionResumptionCounts& get(ServiceContext* serviceContext);
+};
+
 struct CertInformationToLog {
     SSLX509Name subject;
     SSLX509Name issuer;
@@ -354,6 +365,13 @@ public:
      */
     virtual Status stapleOCSPResponse(SSLContextType context, bool asyncOCSPStaple) = 0;
 
+    /**
+     * Called on an outgoing connection to `remoteHost` before its handshake begins. The OpenSSL
+     * implementation uses this to offer a session cached from an earlier handshake with the same
+     * host, so that the handshake can be resumed. No-op for SChannel and SecureTransport.
+     */
+    virtual void prepareEgressHandshake(SSLConnectionType ssl, const HostAndPort& remoteHost) {}
+
     /**
      * Stop jobs after rotation is complete.
      */
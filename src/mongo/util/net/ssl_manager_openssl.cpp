@@ -58,6 +58,7 @@
 #include "mongo/util/debug_util.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/net/cidr.h"
 #include "mongo/util/net/dh_openssl.h"
 #include "mongo/util/net/ocsp/ocsp_manager.h"
@@ -351,6 +352,10 @@ const OCSP_CERTID* OCSP_SINGLERESP_get0_id(const OCSP_SINGLERESP* single) {
 inline bool ASN1_TIME_diff(int*, int*, const ASN1_TIME*, const ASN1_TIME*) {
     return false;
 }
+
+inline int SSL_is_server(const SSL* ssl) {
+    return ssl->server;
+}
 #endif
 
 int DH_set0_pqg(DH* dh, BIGNUM* p, BIGNUM* q, BIGNUM* g) {
@@ -484,6 +489,8 @@ public:
 using UniqueSSLContext =
     std::unique_ptr<SSL_CTX, OpenSSLDeleter<decltype(::SSL_CTX_free), ::SSL_CTX_free>>;
 using UniqueSSL = std::unique_ptr<SSL, OpenSSLDeleter<decltype(::SSL_free), ::SSL_free>>;
+using UniqueSSLSession =
+    std::unique_ptr<SSL_SESSION, OpenSSLDeleter<decltype(::SSL_SESSION_free), ::SSL_SESSION_free>>;
 static const int BUFFER_SIZE = 8 * 1024;
 
 using UniqueOpenSSLStringStack =
@@ -1084,6 +1091,84 @@ struct OCSPStaplingContext {
     Date_t sharedResponseNextUpdate;
 };
 
+/**
+ * Remembers the most recently negotiated TLS session for each remote host this process connects
+ * to, so that the next outgoing connection to that host can resume it instead of performing a full
+ * handshake. Once more than the configured number of hosts are cached, the least recently used
+ * host's session is evicted.
+ */
+class TLSClientSessionCache {
+public:
+    explicit TLSClientSessionCache(size_t capacity) : _sessions(capacity) {}
+
+    /**
+     * Takes ownership of `session` as the newest session negotiated with `host`.
+     */
+    void put(const std::string& host, UniqueSSLSession session) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _sessions.add(host, std::move(session));
+    }
+
+    /**
+     * Offers the session cached for `host`, if any, on `ssl`. Returns true if a session was set.
+     */
+    bool apply(const std::string& host, SSL* ssl) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _sessions.find(host);
+        if (it == _sessions.end()) {
+            return false;
+        }
+
+#if OPENSSL_VERSION_NUMBER >= 0x1010100FL
+        if (!SSL_SESSION_is_resumable(it->second.get())) {
+            _sessions.erase(it);
+            return false;
+        }
+#endif
+
+        return SSL_set_session(ssl, it->second.get()) == 1;
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("TLSClientSessionCache::_mutex");
+    LRUCache<std::string, UniqueSSLSession> _sessions;
+};
+
+/**
+ * Attached to an outgoing SSL object as ex_data so that sessions OpenSSL delivers for it, including
+ * TLS 1.3 tickets which arrive after the handshake has completed, are stored under the right host.
+ */
+struct TLSClientSessionCacheKey {
+    std::shared_ptr<TLSClientSessionCache> cache;
+    std::string host;
+};
+
+void freeTLSClientSessionCacheKey(
+    void* parent, void* ptr, CRYPTO_EX_DATA* ad, int idx, long argl, void* argp) {
+    delete static_cast<TLSClientSessionCacheKey*>(ptr);
+}
+
+int tlsClientSessionCacheKeyIndex() {
+    static const int index =
+        SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, freeTLSClientSessionCacheKey);
+    return index;
+}
+
+/**
+ * Installed as the new session callback on outgoing contexts when the client session cache is
+ * enabled. Returning 1 tells OpenSSL that we have taken the reference to `session`.
+ */
+int newTLSClientSessionCallback(SSL* ssl, SSL_SESSION* session) {
+    auto key = static_cast<TLSClientSessionCacheKey*>(
+        SSL_get_ex_data(ssl, tlsClientSessionCacheKeyIndex()));
+    if (!key) {
+        return 0;
+    }
+
+    key->cache->put(key->host, UniqueSSLSession(session));
+    return 1;
+}
+
 class SSLManagerOpenSSL;
 
 /**
@@ -1187,6 +1272,8 @@ public:
      */
     Status stapleOCSPResponse(SSL_CTX* context, bool asyncOCSPStaple) final;
 
+    void prepareEgressHandshake(SSL* ssl, const HostAndPort& remoteHost) final;
+
     void stopJobs() final;
 
     const SSLConfiguration& getSSLConfiguration() const final {
@@ -1228,6 +1315,9 @@ private:
     // with TransientSSLParams::targetedClusterConnectionString.
     const std::optional<TransientSSLParams> _transientSSLParams;
 
+    // Sessions negotiated on outgoing connections, or null if tlsClientSessionCacheSize is 0.
+    const std::shared_ptr<TLSClientSessionCache> _clientSessionCache;
+
     // Weak pointer to verify that this manager is still owned by this context.
     synchronized_value<std::weak_ptr<const SSLConnectionContext>> _ownedByContext;
 
@@ -1603,6 +1693,9 @@ SSLManagerOpenSSL::SSLManagerOpenSSL(const SSLParams& params,
       _allowInvalidHostnames(params.sslAllowInvalidHostnames),
       _suppressNoCertificateWarning(params.suppressNoTLSPeerCertificateWarning),
       _transientSSLParams(transientSSLParams),
+      _clientSessionCache(tlsClientSessionCacheSize > 0
+                              ? std::make_shared<TLSClientSessionCache>(tlsClientSessionCacheSize)
+                              : nullptr),
       _fetcher(this),
       _serverPEMPassword(params.sslPEMKeyPassword, "Enter PEM passphrase"),
       _clusterPEMPassword(params.sslClusterPassword, "Enter cluster certificate passphrase") {
@@ -2435,6 +2528,14 @@ Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
         }
     }
 
+    if (direction == ConnectionDirection::kOutgoing && _clientSessionCache) {
+        // Outgoing sessions are kept per remote host in _clientSessionCache. OpenSSL's internal
+        // store is keyed by session id, which only a server can look up.
+        ::SSL_CTX_set_session_cache_mode(context,
+                                         SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        ::SSL_CTX_sess_set_new_cb(context, newTLSClientSessionCallback);
+    }
+
     if (tlsOCSPEnabled) {
         if (direction == SSLManagerInterface::ConnectionDirection::kOutgoing) {
             // This should only induce an extra network call if there is no stapled response
@@ -2496,6 +2597,21 @@ Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
     return Status::OK();
 }
 
+void SSLManagerOpenSSL::prepareEgressHandshake(SSL* ssl, const HostAndPort& remoteHost) {
+    if (!_clientSessionCache) {
+        return;
+    }
+
+    auto key = std::make_unique<TLSClientSessionCacheKey>();
+    key->cache = _clientSessionCache;
+    key->host = remoteHost.toString();
+
+    _clientSessionCache->apply(key->host, ssl);
+    if (SSL_set_ex_data(ssl, tlsClientSessionCacheKeyIndex(), key.get()) == 1) {
+        key.release();
+    }
+}
+
 void SSLManagerOpenSSL::registerOwnedBySSLContext(
     std::weak_ptr<const SSLConnectionContext> ownedByContext) {
     _ownedByContext = ownedByContext;
@@ -3099,6 +3215,11 @@ Future<SSLPeerInfo> SSLManagerOpenSSL::parseAndValidatePeerCertificate(
 
     recordTLSVersion(tlsVersionStatus.getValue(), hostForLogging);
 
+    if (SSL_session_reused(conn)) {
+        auto& counts = TLSSessionResumptionCounts::get(getGlobalServiceContext());
+        (SSL_is_server(conn) ? counts.ingress : counts.egress).addAndFetch(1);
+    }
+
     if (!_sslConfiguration.hasCA && isSSLServer)
         return SSLPeerInfo(sni);
 